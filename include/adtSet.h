@@ -3,7 +3,9 @@
  * @brief Header file for the Set abstract data type set.
  *
  * This file provides the prototypes for various functions to manipulate
- * sets that store elements of type Medal.
+ * sets that store elements of type Medal. Two medals are considered the same
+ * element when the set's key function extracts the same key from both, so one
+ * set can deduplicate by discipline, another by athlete, and so on.
  * @author Raul Rohjans
  */
 #pragma once
@@ -15,12 +17,56 @@ struct AdtSetImpl; ///< Forward declaration of the set implementation.
 
 typedef struct AdtSetImpl *PtAdtSet; ///< Pointer to a set implementation.
 
+#define MAX_SET_KEY_LENGTH 160 ///< Maximum length of a key extracted from a Medal.
+
 /**
- * Creates a new set.
+ * Function that extracts the key identifying a Medal in a set.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer of MAX_SET_KEY_LENGTH characters that receives the null terminated key.
+ */
+typedef void (*SetKeyFunction)(const Medal *elem, char *key);
+
+/**
+ * Creates a new set keyed by discipline, game and athlete (see setKeyMedal).
  * @return Pointer to the newly created set.
  */
 PtAdtSet setCreate();
 
+/**
+ * Creates a new set with a specific key function.
+ * @param keyFunction Function that extracts the key of each Medal.
+ * @return Pointer to the newly created set.
+ */
+PtAdtSet setCreateWithKey(SetKeyFunction keyFunction);
+
+/**
+ * Key function that identifies a Medal by discipline, game and athlete.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyMedal(const Medal *elem, char *key);
+
+/**
+ * Key function that identifies a Medal by its discipline only.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyDiscipline(const Medal *elem, char *key);
+
+/**
+ * Key function that identifies a Medal by its game and discipline.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyGameDiscipline(const Medal *elem, char *key);
+
+/**
+ * Key function that identifies a Medal by its athlete.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyAthlete(const Medal *elem, char *key);
+
 /**
  * Destroys a set, freeing all associated resources.
  * @param set The set to be destroyed.
@@ -60,6 +106,7 @@ int setSize(PtAdtSet set);
 
 /**
  * Checks if one set is a subset of another.
+ * Elements of 'subset' are looked up with the key function of 'set'.
  * @param subset The set to check if it is a subset.
  * @param set The set to check against.
  * @return True if `subset` is a subset of `set`, false otherwise.
@@ -93,7 +140,7 @@ Medal* setValues(PtAdtSet set);
 void setPrint(PtAdtSet set);
 
 /**
- * Compares two Medal elements for equality.
+ * Compares two Medal elements for equality by discipline, game and athlete.
  * @param elem1 First Medal element to compare.
  * @param elem2 Second Medal element to compare.
  * @return True if the elements are equal, false otherwise.
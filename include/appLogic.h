@@ -13,41 +13,42 @@
 #include "listMedal.h"
 #include "map.h"
 #include "adtSet.h"
+#include "topAthlete.h"
+#include "athleteCursor.h"
 
-/**
- * @brief Paginates and displays a list of athletes.
- * @param athletes The list of athletes to paginate.
- */
-void paginate(PtList athletes);
+#define MAX_PAGE_SIZE 20  ///< Athletes per page of paginate.
 
 /**
- * @brief Sorts a list of athletes alphabetically by their names.
- * @param athletes Pointer to the list of athletes to be sorted.
+ * @brief Paginates and displays the athletes of a cursor, one page at a time.
+ * @param cursor Cursor opened with a page size of MAX_PAGE_SIZE.
  */
-void orderAthletesAlphabetic(PtList *athletes);
+void paginate(AthleteCursor *cursor);
 
 /**
- * @brief Creates a shallow copy of a list of athletes.
- * @param athletes The original list of athletes.
- * @return A new list containing a shallow copy of the athletes.
+ * @brief Orders a list of athletes alphabetically by their names, ignoring case, without moving them.
+ * 
+ * The order is computed once and reused until the list changes.
+ * 
+ * @param athletes The list of athletes.
+ * @return The ranks of the athletes in name order, owned by the list and valid until it changes, or NULL on failure.
  */
-PtList listAthleteShallowCopy(PtList athletes);
+const int* orderAthletesAlphabetic(PtList athletes);
 
 /**
- * @brief Filters athletes based on the number of participations.
- * @param athletes The list of athletes to filter.
+ * @brief Filters athletes based on the number of participations (see AthleteFilter).
+ * @param athlete The athlete to check.
  * @param participations Minimum number of participations to filter by.
- * @return A new list containing athletes who meet the criteria.
+ * @return True if the athlete participated at least that many times, false otherwise.
  */
-PtList filterAthletesPerParticipation(PtList athletes, int participations);
+bool filterAthletesPerParticipation(const Athlete *athlete, int participations);
 
 /**
- * @brief Filters athletes who first participated in a specific year.
- * @param athletes The list of athletes to filter.
+ * @brief Filters athletes who first participated in a specific year (see AthleteFilter).
+ * @param athlete The athlete to check.
  * @param year The year to filter by.
- * @return A new list containing athletes who first participated in the specified year.
+ * @return True if the athlete first participated in that year, false otherwise.
  */
-PtList filterAthletesPerFirstYear(PtList athletes, int year);
+bool filterAthletesPerFirstYear(const Athlete *athlete, int year);
 
 /**
  * @brief Displays detailed information for a specific athlete based on their ID.
@@ -59,11 +60,15 @@ void showAthleteInfo(PtList athletes, PtListMedal medals, char *athleteID);
 
 /**
  * @brief Retrieves all medals won by a specific athlete.
+ * The result is a view of row numbers into 'medals' (no medal is copied),
+ * served by the athlete index of the list in O(k) for k medals.
  * @param medals The list of all medals.
  * @param athleteID The ID of the athlete to search for.
- * @return A new list containing all medals won by the specified athlete.
+ * @param ptRows Pointer to store the rows of the medals in 'medals', valid until the list changes.
+ * @param ptCount Pointer to store the number of medals.
+ * @return True if the athlete won at least one medal, false otherwise.
  */
-PtListMedal getMedalsPerAthlete(PtListMedal medals, char *athleteID);
+bool getMedalsPerAthlete(PtListMedal medals, char *athleteID, const int **ptRows, int *ptCount);
 
 /**
  * @brief Searches for an athlete by ID.
@@ -75,23 +80,25 @@ PtListMedal getMedalsPerAthlete(PtListMedal medals, char *athleteID);
 bool getAthleteById(PtList athletes, char *athleteID, Athlete* athlete);
 
 /**
- * @brief Filters medals between specified start and end years.
- * @param startYear The starting year of the period.
- * @param endYear The ending year of the period.
- * @param medals The list of medals to filter.
+ * @brief Computes the N athletes with most medals among some rows of a list of medals.
+ * The medals are aggregated per athlete in a single pass over a hash table,
+ * and the best N are then selected with a bounded heap. Ties are broken by athlete ID.
+ * @param n Number of athletes to select.
+ * @param athletes List of all athletes; medals of unknown athletes are ignored.
+ * @param medals The list of all medals.
+ * @param rows Rows of the medals to consider (e.g., from medalFilterRows).
+ * @param medalCount Number of rows.
  * @param hosts Mapping of game identifiers to hosts.
- * @return A list of medals that fall within the specified years.
+ * @return The selected athletes (to be freed with destroyTopNResult), or NULL on memory allocation failure.
  */
-PtListMedal filterMedalsPerDate(int startYear, int endYear, PtListMedal medals, PtMap hosts);
+TopNResult* computeTopN(int n, PtList athletes, PtListMedal medals, const int *rows, int medalCount, PtMap hosts);
 
 /**
- * @brief Filters medals by game type (e.g., Summer or Winter Olympics).
- * @param gameType The type of games to filter (e.g., "Summer").
- * @param medals The list of medals to filter.
- * @param hosts Mapping of game identifiers to hosts, which include the season.
- * @return A list of medals from the specified type of games.
+ * @brief Prints the result of a top N query.
+ * @param result The selected athletes.
+ * @param hosts Mapping of game identifiers to hosts.
  */
-PtListMedal filterMedalsPerGameType(char *gameType, PtListMedal medals, PtMap hosts);
+void printTopN(const TopNResult *result, PtMap hosts);
 
 /**
  * @brief Displays statistics and information for the top N athletes.
@@ -109,7 +116,7 @@ void showTopN(int n, int startYear, int endYear, char *gameType, PtList athletes
  * @brief Retrieves the disciplines of a given game from a set of medals.
  * @param medals The list of medals.
  * @param gameSlug The identifier for the game.
- * @return A set of disciplines associated with the specified game.
+ * @return A set with one medal per discipline of the specified game.
  */
 PtAdtSet getGameSlugDisciplines(PtListMedal medals, char* gameSlug);
 
@@ -126,7 +133,7 @@ void showDisciplineStatistics(PtAdtSet disciplines, PtListMedal medals);
  * @param discipline The discipline to analyze.
  * @return String containing the name of the country with the most medals in the specified discipline.
  */
-char* countryMostMedalsInDiscipline(PtListMedal medals, char* discipline);
+char* countryMostMedalsInDiscipline(PtListMedal medals, const char* discipline);
 
 /**
  * @brief Calculates the proportion of female participants in a specific discipline.
@@ -135,4 +142,4 @@ char* countryMostMedalsInDiscipline(PtListMedal medals, char* discipline);
  * @param womenCount Pointer to store the count of women.
  * @param athleteCount Pointer to store the total count of athletes.
  */
-void getDisciplineWomenProportion(PtListMedal medals, char* discipline, int *womenCount, int *athleteCount);
+void getDisciplineWomenProportion(PtListMedal medals, const char* discipline, int *womenCount, int *athleteCount);
@@ -11,9 +11,13 @@
  */
 #pragma once
 
+#include <stdint.h>
+#include "outputBuffer.h"
+
 #define MAX_ID_LENGTH 50             ///< Maximum length for athlete ID.
 #define MAX_ATHLETE_NAME_LENGTH 100  ///< Maximum length for athlete name.
 #define MAX_GAME_LENGTH 50           ///< Maximum length for game name.
+#define NAME_KEY_WORDS 2             ///< Words of the name sort key, 8 bytes of the name each.
 
 /**
  * Represents an athlete with various personal and participation details.
@@ -24,6 +28,7 @@ typedef struct athlete {
     int gamesParticipations;                    ///< Total number of games participated.
     int yearFirstParticipation;                 ///< Year of first participation in games.
     int athleteBirth;                           ///< Athlete's year of birth.
+    uint64_t nameKey[NAME_KEY_WORDS];           ///< Sort key of the name, see athleteSetNameKey.
 } Athlete;
 
 /**
@@ -48,3 +53,61 @@ Athlete* createEmptyAthlete();
  * @param athlete The Athlete to print.
  */
 void printAthlete(Athlete athlete);
+
+/**
+ * Appends the details of an athlete to an output buffer, as printAthlete prints them.
+ * @param out The buffer.
+ * @param athlete The Athlete to print.
+ */
+void formatAthlete(OutputBuffer *out, const Athlete *athlete);
+
+/**
+ * Computes the sort key of the name of an athlete. Must be called whenever the name changes.
+ *
+ * The first 8 * NAME_KEY_WORDS bytes of the name, with ASCII letters folded
+ * to lowercase, are packed big-endian into the key words, padded with zeros,
+ * so comparing the words as integers orders that prefix ignoring case.
+ * @param athlete The athlete.
+ */
+void athleteSetNameKey(Athlete *athlete);
+
+/**
+ * Returns the name key of an athlete, for sorting (see listSortedOrder).
+ * @param athlete The athlete.
+ * @return The NAME_KEY_WORDS words of the key.
+ */
+const uint64_t* athleteGetNameKey(const Athlete *athlete);
+
+/**
+ * Compares two athletes by name ignoring case, for sorting (see listSort and listSortedOrder).
+ * Only athletes whose name keys are equal have their full names compared;
+ * names that only differ in case are ordered by strcmp.
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareByName(const Athlete *a, const Athlete *b);
+
+/**
+ * Compares two athletes by ID, for sorting (see listSort and listSortedOrder).
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareById(const Athlete *a, const Athlete *b);
+
+/**
+ * Compares two athletes by year of birth, for sorting (see listSort and listSortedOrder).
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareByBirth(const Athlete *a, const Athlete *b);
+
+/**
+ * Compares two athletes by number of games participations, for sorting (see listSort and listSortedOrder).
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareByParticipations(const Athlete *a, const Athlete *b);
@@ -0,0 +1,74 @@
+/**
+ * @file athleteCursor.h
+ * @brief Header file for the lazy cursor over an ordered list of athletes.
+ *
+ * An AthleteCursor pages through the athletes of a list that match a filter,
+ * in the order of a sorted index of ranks (e.g., orderAthletesAlphabetic).
+ * The matching athletes are never collected: each page is found by scanning
+ * the index from the edge of the current page, so moving one page forward or
+ * back only visits the athletes between the two pages.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include "list.h"
+
+/**
+ * Predicate an athlete must satisfy to be visited by a cursor, given the
+ * value the cursor was opened with (e.g., a year).
+ */
+typedef bool (*AthleteFilter)(const Athlete *athlete, int value);
+
+/**
+ * Cursor over the athletes of a list that match a filter. Lives on the
+ * caller's stack and is invalidated by any change to the list.
+ */
+typedef struct athleteCursor {
+    PtList athletes;       ///< The list of athletes.
+    const int *order;      ///< Ranks of all athletes, in the order to visit them.
+    int size;              ///< Number of ranks in 'order'.
+    AthleteFilter filter;  ///< The filter, or NULL to visit every athlete.
+    int filterValue;       ///< Value passed to the filter.
+    int pageSize;          ///< Maximum number of athletes per page.
+    int count;             ///< Number of athletes that match the filter.
+    int page;              ///< Current page, from 0.
+    int first;             ///< Position in 'order' of the first athlete of the page.
+    int end;               ///< Position in 'order' past the last athlete of the page.
+} AthleteCursor;
+
+/**
+ * @brief Opens a cursor on the first page.
+ *
+ * The matching athletes are counted once, without storing them.
+ *
+ * @param cursor The cursor to open.
+ * @param athletes The list of athletes.
+ * @param order Ranks of all athletes of the list, in the order to visit them.
+ * @param filter The filter, or NULL to visit every athlete.
+ * @param filterValue Value passed to the filter.
+ * @param pageSize Maximum number of athletes per page (at least 1).
+ */
+void athleteCursorOpen(AthleteCursor *cursor, PtList athletes, const int *order,
+                       AthleteFilter filter, int filterValue, int pageSize);
+
+/**
+ * @brief Moves a cursor to the next page.
+ * @param cursor The cursor.
+ * @return True if moved, false if the cursor is on the last page.
+ */
+bool athleteCursorNext(AthleteCursor *cursor);
+
+/**
+ * @brief Moves a cursor to the previous page.
+ * @param cursor The cursor.
+ * @return True if moved, false if the cursor is on the first page.
+ */
+bool athleteCursorPrevious(AthleteCursor *cursor);
+
+/**
+ * @brief Retrieves the athletes of the current page, read in place.
+ * @param cursor The cursor.
+ * @param rows Array with room for 'pageSize' athletes, receives the athletes of the page in order.
+ * @return Number of athletes written.
+ */
+int athleteCursorRows(const AthleteCursor *cursor, const Athlete **rows);
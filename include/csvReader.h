@@ -0,0 +1,138 @@
+/**
+ * @file csvReader.h
+ * @brief Header file for the memory-mapped CSV reader.
+ *
+ * Declares a small reader that maps a whole CSV file into memory and
+ * tokenizes it in place. Each field is returned as a view (pointer and
+ * length) into the mapped buffer, so no per-line or per-field heap
+ * allocations are performed while reading.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define CSV_DELIMITER ';'  ///< Field delimiter used by every data file.
+
+/**
+ * Represents a single field of a CSV record as a view into the file buffer.
+ * The view is NOT null terminated and is only valid while the reader is open.
+ */
+typedef struct csvField {
+    const char *data;  ///< First character of the field (outer quotes excluded).
+    int length;        ///< Number of characters in the field.
+    bool quoted;       ///< True if the field was quoted and may contain escaped quotes.
+} CsvField;
+
+/**
+ * Function that stores the value of one column into the record being built.
+ * @param record Record being filled (e.g., an Athlete).
+ * @param field Value of the column for the current row.
+ */
+typedef void (*CsvFieldHandler)(void *record, CsvField field);
+
+/**
+ * Associates a header name with the handler that parses that column.
+ * A NULL handler marks a known column whose value is not stored.
+ */
+typedef struct csvColumn {
+    const char *header;       ///< Header name as it appears in the first line.
+    CsvFieldHandler handler;  ///< Handler for the column, or NULL to ignore it.
+} CsvColumn;
+
+/**
+ * Represents an open CSV file and the current read position inside it.
+ */
+typedef struct csvReader {
+    const char *buffer;  ///< Start of the file contents.
+    size_t size;         ///< Size of the file contents in bytes.
+    size_t position;     ///< Offset of the next record to read.
+    bool mapped;         ///< True if 'buffer' is a memory mapping, false if heap allocated.
+    bool owner;          ///< True if closing the reader releases 'buffer' (false for chunks).
+} CsvReader;
+
+/**
+ * @brief Opens a CSV file and maps its whole contents into memory.
+ * @param reader Reader to initialize.
+ * @param path Path of the file to open.
+ * @return True if the file was opened, false otherwise.
+ */
+bool csvOpen(CsvReader *reader, const char *path);
+
+/**
+ * @brief Releases the file contents held by a reader.
+ * All field views obtained from the reader become invalid.
+ * @param reader Reader to close.
+ */
+void csvClose(CsvReader *reader);
+
+/**
+ * @brief Reads the next record of a CSV file.
+ * Empty lines are skipped and line endings (LF or CRLF) are not part of any field.
+ * A record always ends at the end of its line: a quoted field cannot hold a
+ * line break, and a quote left open ends there. Fields beyond 'maxFields' are ignored.
+ * @param reader Reader to read from.
+ * @param fields Array that receives the field views.
+ * @param maxFields Capacity of 'fields'.
+ * @return Number of fields read, or -1 when there are no more records.
+ */
+int csvNextRecord(CsvReader *reader, CsvField *fields, int maxFields);
+
+/**
+ * @brief Splits the unread part of a file into newline-aligned chunks.
+ * Each chunk is a reader over a slice of the same buffer, holding only whole
+ * records, so chunks can be parsed independently (e.g., on different threads).
+ * Chunks do not own the buffer and are only valid while 'reader' is open.
+ * @param reader Reader to split; its position is not changed.
+ * @param chunkCount Maximum number of chunks to produce.
+ * @param chunks Array of at least 'chunkCount' readers that receives the chunks.
+ * @return Number of chunks produced, which may be less than 'chunkCount'.
+ */
+int csvSplit(const CsvReader *reader, int chunkCount, CsvReader *chunks);
+
+/**
+ * @brief Checks if a field matches a string exactly.
+ * @param field Field to compare.
+ * @param str Null terminated string to compare with.
+ * @return True if both have the same contents, false otherwise.
+ */
+bool csvFieldEquals(CsvField field, const char *str);
+
+/**
+ * @brief Copies a field into a null terminated buffer.
+ * The copy is truncated if the buffer is too small and escaped quotes are collapsed.
+ * @param field Field to copy.
+ * @param dest Destination buffer.
+ * @param destSize Size of the destination buffer.
+ */
+void csvFieldCopy(CsvField field, char *dest, int destSize);
+
+/**
+ * @brief Parses a field as a decimal integer.
+ * @param field Field to parse.
+ * @return The parsed value, or 0 if the field is empty or not numeric.
+ */
+int csvFieldToInt(CsvField field);
+
+/**
+ * @brief Resolves a header row into a per-column handler table.
+ * This is done once per file so each field of a row is dispatched with an
+ * indexed call instead of comparing its header name. Empty headers are ignored.
+ * @param headers Fields of the header row.
+ * @param headerCount Number of fields in the header row.
+ * @param columns Known columns of the file.
+ * @param columnCount Number of known columns.
+ * @param handlers Array of at least 'headerCount' entries that receives the handlers.
+ * @return True if every header is known, false if an invalid column was found.
+ */
+bool csvResolveColumns(const CsvField *headers, int headerCount, const CsvColumn *columns, int columnCount, CsvFieldHandler *handlers);
+
+/**
+ * @brief Dispatches the fields of a row to their resolved handlers.
+ * @param record Record being filled.
+ * @param fields Fields of the row.
+ * @param fieldCount Number of fields in the row.
+ * @param handlers Handler table produced by csvResolveColumns.
+ * @param handlerCount Number of entries in 'handlers'.
+ */
+void csvApplyRecord(void *record, const CsvField *fields, int fieldCount, const CsvFieldHandler *handlers, int handlerCount);
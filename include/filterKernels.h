@@ -0,0 +1,84 @@
+/**
+ * @file filterKernels.h
+ * @brief Header file for the vectorized predicate kernels over columns.
+ *
+ * Each kernel evaluates one predicate over a whole column and writes the
+ * result as a selection bitmap: bit (row % 64) of word (row / 64) is set when
+ * the row matches, and the unused bits of the last word are cleared. Bitmaps
+ * of several predicates are then intersected with bitmapAnd.
+ *
+ * The kernels are implemented with AVX2, SSE2 and plain C. The best version
+ * supported by the processor is selected the first time a kernel runs.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BITMAP_WORDS(count) (((count) + 63) / 64)  ///< Number of words of a bitmap of 'count' rows.
+
+/**
+ * @brief Selects the rows where an int column equals a value.
+ * @param column The column.
+ * @param count Number of rows.
+ * @param value The value to compare with.
+ * @param bitmap Bitmap of BITMAP_WORDS(count) words that receives the selection.
+ */
+void kernelEqualsInt(const int *column, int count, int value, uint64_t *bitmap);
+
+/**
+ * @brief Selects the rows where a char column equals a value.
+ * @param column The column.
+ * @param count Number of rows.
+ * @param value The value to compare with.
+ * @param bitmap Bitmap of BITMAP_WORDS(count) words that receives the selection.
+ */
+void kernelEqualsChar(const char *column, int count, char value, uint64_t *bitmap);
+
+/**
+ * @brief Selects the rows whose code belongs to a set.
+ * @param column Column of codes.
+ * @param count Number of rows.
+ * @param set Membership of each code: set[code] is non-zero when the code is in the set.
+ * @param setSize Number of entries of 'set', codes outside [0, setSize) are not in the set.
+ * @param bitmap Bitmap of BITMAP_WORDS(count) words that receives the selection.
+ */
+void kernelInSet(const int *column, int count, const int *set, int setSize, uint64_t *bitmap);
+
+/**
+ * @brief Intersects a bitmap with another one (dest &= src).
+ * @param dest Bitmap that receives the result.
+ * @param src Second operand.
+ * @param words Number of words of both bitmaps.
+ */
+void bitmapAnd(uint64_t *dest, const uint64_t *src, int words);
+
+/**
+ * @brief Counts the selected rows of a bitmap.
+ * @param bitmap The bitmap.
+ * @param words Number of words.
+ * @return Number of set bits.
+ */
+int bitmapCount(const uint64_t *bitmap, int words);
+
+/**
+ * @brief Lists the selected rows of a bitmap, in ascending order.
+ * @param bitmap The bitmap.
+ * @param words Number of words.
+ * @param rows Array with room for bitmapCount(bitmap, words) rows.
+ * @return Number of rows written.
+ */
+int bitmapToRows(const uint64_t *bitmap, int words, int *rows);
+
+/**
+ * @brief Returns the name of the instruction set used by the kernels ("avx2", "sse2" or "scalar").
+ * @return The name of the selected implementation.
+ */
+const char* kernelInstructionSet();
+
+/**
+ * @brief Forces the kernels to use an instruction set, e.g. to compare implementations.
+ * @param name "avx2", "sse2" or "scalar".
+ * @return True if selected, false if unknown or not supported by the processor.
+ */
+bool kernelUseInstructionSet(const char *name);
@@ -2,13 +2,14 @@
  * @file helpers.h
  * @brief Header file for helper functions used in the Olympics Super Parser program.
  *
- * Declares utility functions for string manipulation, sorting algorithms,
- * date handling, and other general-purpose functions that support various
- * operations across the program. These functions include user interface
- * components, date calculations, quick sort implementation, and more.
+ * Declares utility functions for string manipulation, date handling, and
+ * other general-purpose functions that support various operations across
+ * the program. These functions include user interface components, date
+ * calculations, and more.
  */
 #pragma once
 
+#include <stdint.h>
 #include "list.h"
 
 /**
@@ -29,7 +30,7 @@ int getNumbersFromString(char *str);
  * @param str The original string containing both digits and characters.
  * @return A dynamically allocated string containing only the characters from the original string.
  */
-char* getCharsOnlyFromString(char *str);
+char* getCharsOnlyFromString(const char *str);
 
 /**
  * @brief Calculates the number of days between two dates.
@@ -62,40 +63,53 @@ int concatenate(int x, int y);
 void clearScreen();
 
 /**
- * @brief Implements a quick sort on a list of athletes.
- * @param athletes Pointer to the list of athletes.
- * @param low The starting index for the sort.
- * @param high The ending index for the sort.
+ * @brief Extracts the year from a date string.
+ * @param date The date string in the format YYYY-MM-DD.
+ * @return The year as an integer.
  */
-void quickSort(PtList *athletes, int low, int high);
+int getYearFromDate(char* date);
 
 /**
- * @brief Partitions a list for quick sorting by selecting a pivot and reordering elements.
- * @param athletes Pointer to the list of athletes.
- * @param low The lower index for partitioning.
- * @param high The higher index for partitioning.
- * @return The index of the pivot after partitioning.
+ * @brief Converts a string to lowercase.
+ * @param str The string to convert.
+ * @return A dynamically allocated string containing the lowercase version of the input.
  */
-int partition(PtList *athletes, int low, int high);
+char* stringToLower(const char* str);
 
 /**
- * @brief Swaps two athletes in a list.
- * @param athletes Pointer to the list of athletes.
- * @param i Index of the first athlete.
- * @param j Index of the second athlete to swap with the first.
+ * @brief Compares two strings ignoring case, without allocating lowercase copies.
+ * @param str1 The first string.
+ * @param str2 The second string.
+ * @return 0 if the strings are equal ignoring case, a negative or positive value
+ * if the first string sorts before or after the second, as strcmp does.
  */
-void swapAthletes(PtList *athletes, int i, int j);
+int compareIgnoreCase(const char *str1, const char *str2);
 
 /**
- * @brief Extracts the year from a date string.
- * @param date The date string in the format YYYY-MM-DD.
- * @return The year as an integer.
+ * @brief Hashes a string with the 32-bit FNV-1a hash, for the hash tables of the program.
+ *
+ * Snapshots save the athlete ID index built with this hash, so changing it
+ * requires a new SNAPSHOT_VERSION.
+ *
+ * @param str The string to hash.
+ * @return The hash of the string.
  */
-int getYearFromDate(char* date);
+unsigned int hashString(const char *str);
 
 /**
- * @brief Converts a string to lowercase.
- * @param str The string to convert.
- * @return A dynamically allocated string containing the lowercase version of the input.
+ * @brief Sorts keys of unsigned words, moving an item along with each key.
+ *
+ * Keys are ordered by their first word, then by the next one, and so on,
+ * as unsigned integers (e.g., a name key, see athleteSetNameKey). The sort
+ * is stable: items with equal keys keep their relative order. Below a small
+ * size the keys are sorted by insertion; above it, with an MSD radix sort
+ * that reads each byte of a key at most once per pass, instead of comparing
+ * keys O(n log n) times.
+ *
+ * @param keys Keys to sort, each pointing to 'words' words.
+ * @param words Number of words of each key.
+ * @param items Item of each key (e.g., a slot of a list).
+ * @param count Number of keys.
+ * @return 1 if successful, 0 on memory allocation failure (keys and items are left as they were).
  */
-char* stringToLower(char* str);
+int sortKeyWords(const uint64_t **keys, int words, int *items, int count);
@@ -8,6 +8,8 @@
  */
 #pragma once
 
+#include "outputBuffer.h"
+
 #define MAX_ID_LENGTH 50         ///< Maximum length for unique identifier.
 #define MAX_HOST_NAME_LENGTH 50  ///< Maximum length for names related to the host.
 #define MAX_LOCATION_LENGTH 100  ///< Maximum length for the location description.
@@ -24,6 +26,11 @@ typedef struct {
     char gameName[MAX_GAME_NAME_LENGTH];   ///< Official name of the game.
     char season[MAX_HOST_NAME_LENGTH];     ///< Season during which the game is held.
     int year;                              ///< Year the event is hosted.
+    int startYear;                         ///< Year of the start date (0 if the date is invalid).
+    int endYear;                           ///< Year of the end date (0 if the date is invalid).
+    int startJulian;                       ///< Julian day number of the start date.
+    int endJulian;                         ///< Julian day number of the end date.
+    int duration;                          ///< Days between start and end dates, or -1 if a date is invalid.
 } Host;
 
 /**
@@ -40,12 +47,29 @@ typedef struct {
 Host* createHost(const char* slug, const char* endDate, const char* startDate, const char* location,
                  const char* gameName, const char* season, int year);
 
+/**
+ * @brief Parses the start and end dates of a Host into its numeric date fields.
+ * 
+ * Dates are parsed once, when the Host is created or imported, so queries only
+ * compare integers instead of parsing the date strings again.
+ * 
+ * @param host The Host whose startDate and endDate are parsed.
+ */
+void computeHostDates(Host *host);
+
 /**
  * @brief Prints the details of a Host to standard output.
  * @param host The Host to print.
  */
 void printHost(Host host);
 
+/**
+ * @brief Appends the details of a Host to an output buffer, as printHost prints them.
+ * @param out The buffer.
+ * @param host The Host to print.
+ */
+void formatHost(OutputBuffer *out, const Host *host);
+
 /**
  * @brief Creates an empty Host instance with uninitialized fields.
  * @return Pointer to the newly created empty Host instance.
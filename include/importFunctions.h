@@ -12,12 +12,26 @@
 #include "listMedal.h"
 #include "map.h"
 
+#define DEFAULT_IMPORT_THREADS 4  ///< Default number of threads used to parse large files.
+#define IMPORT_THREADS_VARIABLE "OLYMPICS_IMPORT_THREADS"  ///< Environment variable that sets the number of threads (see setImportThreadCount).
+
+/**
+ * @brief Sets the number of worker threads used to parse athletes and medals.
+ *
+ * Large files are split into newline-aligned chunks, one per thread, and the parsed
+ * rows are concatenated in their original order. Small files are always parsed on
+ * the calling thread.
+ *
+ * @param count Number of threads (clamped to at least 1).
+ */
+void setImportThreadCount(int count);
 
 /**
  * @brief Imports a list of athletes from a CSV file.
  * 
  * Reads athletes data from a predefined CSV file format and constructs a list of Athlete structures.
  * Each line in the CSV is expected to represent one athlete with fields separated by semicolons.
+ * An up-to-date binary snapshot is used instead of the CSV file when available.
  *
  * @return A pointer to a list of Athlete structures, or NULL if the file cannot be opened or if parsing fails.
  */
@@ -28,6 +42,7 @@ PtList importAthletes();
  *
  * Reads medals data from a predefined CSV file format and constructs a list of Medal structures.
  * Each line in the CSV is expected to represent one medal with fields separated by semicolons.
+ * An up-to-date binary snapshot is used instead of the CSV file when available.
  *
  * @return A pointer to a list of Medal structures, or NULL if the file cannot be opened or if parsing fails.
  */
@@ -39,7 +54,49 @@ PtListMedal importMedals();
  * Reads host data from a predefined CSV file format and constructs a map where each key is a game slug
  * and the value is a Host structure representing the host details of that game.
  * Each line in the CSV is expected to represent one host with fields separated by semicolons.
+ * An up-to-date binary snapshot is used instead of the CSV file when available.
  *
  * @return A pointer to a map of Host structures, or NULL if the file cannot be opened or if parsing fails.
  */
 PtMap importHosts();
+
+
+/**
+ * @brief Links every medal to the host of its game.
+ * 
+ * Stores in each medal the index of its host in the map (see mapIndexOf), so
+ * queries read host attributes by index instead of looking up the game slug.
+ * Must be called again whenever medals or hosts are (re)loaded.
+ * 
+ * @param medals The medals to link.
+ * @param hosts The hosts, or NULL to unlink every medal.
+ * @return Number of medals whose host was found.
+ */
+int linkMedalHosts(PtListMedal medals, PtMap hosts);
+
+/**
+ * @brief Imports athletes, medals and hosts concurrently.
+ *
+ * Each file is imported on its own thread and the function returns once all three
+ * have finished, so the total time is that of the slowest file rather than the sum.
+ *
+ * @param ptAthletes [out] address of variable to hold the athletes, or NULL if they could not be imported.
+ * @param ptMedals [out] address of variable to hold the medals, or NULL if they could not be imported.
+ * @param ptHosts [out] address of variable to hold the hosts, or NULL if they could not be imported.
+ * @return True if all three files were imported, false otherwise.
+ */
+bool importAll(PtList *ptAthletes, PtListMedal *ptMedals, PtMap *ptHosts);
+
+/**
+ * @brief Restores the data sets saved by a previous session.
+ *
+ * Every import writes a binary snapshot next to its CSV file. This function loads
+ * each data set whose snapshot is valid and whose CSV file has the same size and
+ * modification time as when the snapshot was written; the others are left as NULL.
+ *
+ * @param ptAthletes [out] address of variable to hold the athletes, or NULL if there is no valid snapshot.
+ * @param ptMedals [out] address of variable to hold the medals, or NULL if there is no valid snapshot.
+ * @param ptHosts [out] address of variable to hold the hosts, or NULL if there is no valid snapshot.
+ * @return True if at least one data set was restored, false otherwise.
+ */
+bool importFromSnapshots(PtList *ptAthletes, PtListMedal *ptMedals, PtMap *ptHosts);
\ No newline at end of file
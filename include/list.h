@@ -16,9 +16,11 @@
 #define LIST_EMPTY			3
 #define LIST_FULL			4
 #define LIST_INVALID_RANK	5
+#define LIST_UNKNOWN_ID		6
 
 #include "listElem.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /** Forward declaration of the data structure. */
 struct listImpl;
@@ -26,6 +28,32 @@ struct listImpl;
 /** Definition of pointer to the  data stucture. */
 typedef struct listImpl *PtList;
 
+/**
+ * Forward iterator over the elements of a list, by rank.
+ * 
+ * Lives on the caller's stack and reads the elements in place. It is
+ * invalidated by any operation that adds or removes elements.
+ */
+typedef struct listIterator {
+    const ListElem *next;  ///< Next element to visit.
+    const ListElem *end;   ///< Past the last element.
+} ListIterator;
+
+/**
+ * Comparison function used to sort a list: returns a negative, zero or
+ * positive value if the first element comes before, with or after the
+ * second one (e.g., athleteCompareByName, athleteCompareById,
+ * athleteCompareByBirth or athleteCompareByParticipations).
+ */
+typedef int (*ListElemComparator)(const ListElem *a, const ListElem *b);
+
+/**
+ * Function that returns the sort key of an element: LIST_ELEM_KEY_WORDS
+ * words compared as unsigned integers (e.g., athleteGetNameKey). Elements
+ * with different keys must compare in the order of their keys.
+ */
+typedef const uint64_t* (*ListElemKey)(const ListElem *elem);
+
 /**
  * @brief Creates a new empty list.
  * 
@@ -61,6 +89,86 @@ int listDestroy(PtList *ptList);
  */
 int listAdd(PtList list, int rank, ListElem elem);
 
+/**
+ * @brief Reserves room for a number of elements.
+ * 
+ * Appending until the list holds 'capacity' elements does not reallocate.
+ * Smaller values than the current capacity are ignored.
+ * 
+ * @param list [in] pointer to the list
+ * @param capacity [in] number of elements to reserve room for
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listReserve(PtList list, int capacity);
+
+/**
+ * @brief Adds an element at the end of a list.
+ * 
+ * Same as listAdd at rank 'size', without shifting any element.
+ * 
+ * @param list [in] pointer to the list
+ * @param elem  [in] element to add
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listAppend(PtList list, ListElem elem);
+
+/**
+ * @brief Adds an array of elements at the end of a list, in order.
+ * 
+ * Either every element is added or the list is left unchanged.
+ * 
+ * @param list [in] pointer to the list
+ * @param elems  [in] elements to add
+ * @param count  [in] number of elements in 'elems'
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' or 'elems' is NULL 
+ */
+int listAppendN(PtList list, const ListElem *elems, int count);
+
+/**
+ * @brief Retrieves a copy of the ID index of a list, e.g., to save it with the elements.
+ * 
+ * Each entry holds the rank of an element, or a negative value for a free
+ * entry. The copy only fits a list holding the same elements in the same
+ * ranks (see listAppendNIndexed).
+ * 
+ * @param list [in] pointer to the list
+ * @param ptSlots [out] address of variable to hold the entries (to be freed by the caller)
+ * @param ptSlotCount [out] address of variable to hold the number of entries
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if an argument is NULL 
+ */
+int listIdIndex(PtList list, int **ptSlots, int *ptSlotCount);
+
+/**
+ * @brief Fills an empty list with elements and the ID index saved with them.
+ * 
+ * The index (see listIdIndex) is adopted instead of hashing every ID
+ * again. If the list is not empty or the index does not fit the elements,
+ * this behaves as listAppendN.
+ * 
+ * @param list [in] pointer to the list
+ * @param elems [in] elements to append, in order
+ * @param count [in] number of elements
+ * @param slots [in] entries of the ID index
+ * @param slotCount [in] number of entries
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if an argument is NULL 
+ */
+int listAppendNIndexed(PtList list, const ListElem *elems, int count, const int *slots, int slotCount);
+
 /**
  * @brief Removes an element from a list.
  * 
@@ -93,6 +201,41 @@ int listRemove(PtList list, int rank, ListElem *ptElem);
  */
 int listGet(PtList list, int rank, ListElem *ptElem);
 
+/**
+ * @brief Retrieves a read-only pointer to an element of a list, without copying it.
+ * 
+ * The specified rank must be in [0, size - 1]. The pointer remains valid
+ * until an element is added to or removed from the list.
+ * 
+ * @param list [in] pointer to the list
+ * @param rank [in] rank of the element
+ * 
+ * @return pointer to the element, or
+ * @return NULL if 'rank' is invalid or 'list' is NULL
+ */
+const ListElem* listGetRef(PtList list, int rank);
+
+/**
+ * @brief Positions an iterator before the first element of a list.
+ * 
+ * @param list [in] pointer to the list
+ * @param it [out] iterator to initialize
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NULL if 'list' or 'it' is NULL 
+ */
+int listIterator(PtList list, ListIterator *it);
+
+/**
+ * @brief Advances an iterator.
+ * 
+ * @param it [in] the iterator
+ * 
+ * @return read-only pointer to the next element, or
+ * @return NULL if every element was visited
+ */
+const ListElem* listIteratorNext(ListIterator *it);
+
 /**
  * @brief Replaces an element from a list.
  * 
@@ -108,6 +251,7 @@ int listGet(PtList list, int rank, ListElem *ptElem);
  * @return LIST_OK if successful and previous value in 'ptOldElem', or
  * @return LIST_INVALID_RANK if 'rank' is invalid, or
  * @return LIST_EMPTY if the list is empty, or
+ * @return LIST_NO_MEMORY if the ID index could not grow, or
  * @return LIST_NULL if 'list' is NULL 
  */
 int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem);
@@ -146,6 +290,62 @@ bool listIsEmpty(PtList list);
  */
 int listClear(PtList list);
 
+/**
+ * @brief Finds the rank of an athlete by its ID.
+ * 
+ * Lookups use an index kept in sync by every operation on the list,
+ * so they take constant expected time. If several athletes share
+ * the same ID, the lowest rank is returned.
+ * 
+ * @param list [in] pointer to the list
+ * @param athleteID [in] ID of the athlete to find
+ * @param ptRank [out] address of variable to hold the rank
+ * 
+ * @return LIST_OK if successful and rank in 'ptRank', or
+ * @return LIST_UNKNOWN_ID if no athlete has that ID, or
+ * @return LIST_NULL if 'list' or 'athleteID' is NULL 
+ */
+int listFindById(PtList list, const char *athleteID, int *ptRank);
+
+/**
+ * @brief Sorts a list in place.
+ * 
+ * The sort is stable: elements that compare equal keep their relative
+ * order. It takes O(n log n) time even on already sorted input.
+ * 
+ * @param list [in] pointer to the list
+ * @param compare [in] comparison function
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' or 'compare' is NULL 
+ */
+int listSort(PtList list, ListElemComparator compare);
+
+/**
+ * @brief Retrieves the ranks of a list in sorted order, leaving the list as is.
+ * 
+ * 'ptOrder' receives one rank per element, in sorted order. Elements that
+ * compare equal keep the order of their ranks. The order is computed on the
+ * first call and reused by the next ones until the list is changed or a
+ * different key or comparison function is used. It is owned by the list and
+ * remains valid until then.
+ * 
+ * With a key function, the elements are sorted by radix on their keys (see
+ * sortKeyWords) and only those with equal keys are compared. Without one,
+ * all of them are sorted by comparisons.
+ * 
+ * @param list [in] pointer to the list
+ * @param key [in] key function, or NULL to sort by comparisons only
+ * @param compare [in] comparison function
+ * @param ptOrder [out] address of variable to hold the ranks
+ * 
+ * @return LIST_OK if successful and ranks in 'ptOrder', or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list', 'compare' or 'ptOrder' is NULL 
+ */
+int listSortedOrder(PtList list, ListElemKey key, ListElemComparator compare, const int **ptOrder);
+
 /**
  * @brief Prints the contents of a list.
  * 
@@ -14,3 +14,6 @@
 
 /** Type definition. Change according to the use-case. */
 typedef Athlete ListElem;
+
+/** Number of words of the sort keys of the elements (see ListElemKey). */
+#define LIST_ELEM_KEY_WORDS NAME_KEY_WORDS
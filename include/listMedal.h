@@ -20,6 +20,28 @@
 #include "medal.h"
 #include <stdbool.h>
 
+/**
+ * Read-only view of the columns of a list of medals.
+ * 
+ * Every array has 'size' entries indexed by row. The text fields hold codes
+ * of the medal dictionaries (see medalString) and 'athlete' holds ordinals
+ * of the athlete IDs of the list (see listMedalAthleteId). The arrays remain
+ * valid until the list is changed.
+ */
+typedef struct medalColumns {
+    int size;                     ///< Number of rows.
+    const int *discipline;        ///< Medal.discipline of each row.
+    const int *game;              ///< Medal.game of each row.
+    const int *eventTitle;        ///< Medal.eventTitle of each row.
+    const int *gender;            ///< Medal.gender of each row.
+    const char *medalType;        ///< Medal.medalType of each row.
+    const char *participantType;  ///< Medal.participantType of each row.
+    const int *athlete;           ///< Ordinal of Medal.athleteID of each row.
+    const int *country;           ///< Medal.country of each row.
+    const int *hostIndex;         ///< Medal.hostIndex of each row.
+    int athleteCount;             ///< Number of athlete ordinals, the valid ones being [0, athleteCount).
+} MedalColumns;
+
 /** Forward declaration of the data structure. */
 struct listImpl;
 
@@ -61,6 +83,50 @@ int listMedalDestroy(PtListMedal *ptList);
  */
 int listMedalAdd(PtListMedal list, int rank, Medal elem);
 
+/**
+ * @brief Reserves room for a number of elements.
+ * 
+ * Appending until the list holds 'capacity' elements does not reallocate.
+ * Smaller values than the current capacity are ignored.
+ * 
+ * @param list [in] pointer to the list
+ * @param capacity [in] number of elements to reserve room for
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listMedalReserve(PtListMedal list, int capacity);
+
+/**
+ * @brief Adds an element at the end of a list.
+ * 
+ * Same as listMedalAdd at rank 'size', without shifting any element.
+ * 
+ * @param list [in] pointer to the list
+ * @param elem  [in] element to add
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listMedalAppend(PtListMedal list, Medal elem);
+
+/**
+ * @brief Adds an array of elements at the end of a list, in order.
+ * 
+ * Either every element is added or the list is left unchanged.
+ * 
+ * @param list [in] pointer to the list
+ * @param elems  [in] elements to add
+ * @param count  [in] number of elements in 'elems'
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' or 'elems' is NULL 
+ */
+int listMedalAppendN(PtListMedal list, const Medal *elems, int count);
+
 /**
  * @brief Removes an element from a list.
  * 
@@ -146,6 +212,99 @@ bool listMedalIsEmpty(PtListMedal list);
  */
 int listMedalClear(PtListMedal list);
 
+/**
+ * @brief Builds the index from athlete ID to the rows of that athlete's medals.
+ * 
+ * The index is built in a single pass and kept until the list changes,
+ * so it is usually built once, right after the medals are imported.
+ * Calling this on a list whose index is up to date does nothing.
+ * 
+ * @param list [in] pointer to the list
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if 'list' is NULL 
+ */
+int listMedalIndexAthletes(PtListMedal list);
+
+/**
+ * @brief Retrieves the rows of the medals won by an athlete.
+ * 
+ * The rows are a view into the athlete index, in ascending order, and
+ * remain valid until the list is changed. The index is (re)built first
+ * if it is out of date, otherwise the lookup takes constant expected time.
+ * 
+ * @param list [in] pointer to the list
+ * @param athleteID [in] ID of the athlete
+ * @param ptRows [out] address of variable to hold the rows (NULL if none)
+ * @param ptCount [out] address of variable to hold the number of rows
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if the index could not be built, or
+ * @return LIST_NULL if an argument is NULL 
+ */
+int listMedalRowsOfAthlete(PtListMedal list, const char *athleteID, const int **ptRows, int *ptCount);
+
+/**
+ * @brief Retrieves the whole athlete index of a list, e.g., to save it with the medals.
+ * 
+ * The rows of the athlete with ordinal 'a' (see MedalColumns.athlete) are
+ * rows[groupStart[a]] to rows[groupStart[a + 1] - 1]. The index is built
+ * first if it is out of date. The views remain valid until the list is changed.
+ * 
+ * @param list [in] pointer to the list
+ * @param ptRows [out] address of variable to hold the rows grouped by athlete
+ * @param ptGroupStart [out] address of variable to hold the start of each athlete ('ptGroupCount' + 1 entries)
+ * @param ptGroupCount [out] address of variable to hold the number of athlete ordinals
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if the index could not be built, or
+ * @return LIST_NULL if an argument is NULL 
+ */
+int listMedalAthleteIndex(PtListMedal list, const int **ptRows, const int **ptGroupStart, int *ptGroupCount);
+
+/**
+ * @brief Sets the athlete index of a list from a saved copy (see listMedalAthleteIndex).
+ * 
+ * The copy is checked against the list, in a single pass over its rows.
+ * If it does not match, the index is built from the list instead.
+ * 
+ * @param list [in] pointer to the list
+ * @param rows [in] rows grouped by athlete
+ * @param groupStart [in] start of each athlete in 'rows' ('groupCount' + 1 entries)
+ * @param groupCount [in] number of athlete ordinals
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NO_MEMORY if unsufficient memory for allocation, or
+ * @return LIST_NULL if an argument is NULL 
+ */
+int listMedalSetAthleteIndex(PtListMedal list, const int *rows, const int *groupStart, int groupCount);
+
+/**
+ * @brief Retrieves read-only views of the columns of a list.
+ * 
+ * Scans that only need a few fields should read them here instead of
+ * assembling every row with listMedalGet.
+ * 
+ * @param list [in] pointer to the list
+ * @param columns [out] address of variable to hold the columns
+ * 
+ * @return LIST_OK if successful, or
+ * @return LIST_NULL if an argument is NULL 
+ */
+int listMedalColumns(PtListMedal list, MedalColumns *columns);
+
+/**
+ * @brief Retrieves the athlete ID with a given ordinal.
+ * 
+ * @param list [in] pointer to the list
+ * @param athlete [in] ordinal of the athlete (see MedalColumns.athlete)
+ * 
+ * @return The athlete ID, or
+ * @return NULL if 'list' is NULL or the ordinal is invalid
+ */
+const char* listMedalAthleteId(PtListMedal list, int athlete);
+
 /**
  * @brief Prints the contents of a list.
  * 
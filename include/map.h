@@ -26,6 +26,17 @@ struct mapImpl;
 /** Definition of pointer to the  data stucture. */
 typedef struct mapImpl *PtMap;
 
+/**
+ * Forward iterator over the pairs of a map, by index (see mapIndexOf).
+ * 
+ * Lives on the caller's stack and reads the pairs in place. It is
+ * invalidated by any operation that changes the map.
+ */
+typedef struct mapIterator {
+    PtMap map;  ///< The map being visited.
+    int index;  ///< Index of the next pair to visit.
+} MapIterator;
+
 /**
  * @brief Creates a new empty map.
  * 
@@ -110,6 +121,90 @@ int mapGet(PtMap map, MapKey key, MapValue *ptValue);
  */
 bool mapContains(PtMap map, MapKey key);
 
+/**
+ * @brief Retrieves the index of a key in a map.
+ * 
+ * Pairs are numbered from 0 to size - 1, in the same order used by
+ * mapKeys and mapValues, so an index can stand for its key (e.g., to
+ * store a compact reference). Indexes remain valid until the map is
+ * changed by mapRemove or mapClear.
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key to find
+ * @param ptIndex [out] address of variable to hold the index
+ * 
+ * @return MAP_OK if successful and index in 'ptIndex', or
+ * @return MAP_UNKNOWN_KEY if 'key' doesn't exist, or
+ * @return MAP_EMPTY if the map is empty, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapIndexOf(PtMap map, MapKey key, int *ptIndex);
+
+/**
+ * @brief Retrieves the value at an index of a map (see mapIndexOf).
+ * 
+ * @param map [in] pointer to the map
+ * @param index [in] index of the value
+ * @param ptValue [out] address of variable to hold the value
+ * 
+ * @return MAP_OK if successful and value in 'ptValue', or
+ * @return MAP_UNKNOWN_KEY if 'index' is out of bounds, or
+ * @return MAP_EMPTY if the map is empty, or
+ * @return MAP_NULL if 'map' is NULL 
+ */
+int mapGetAt(PtMap map, int index, MapValue *ptValue);
+
+/**
+ * @brief Retrieves a read-only pointer to the value associated with
+ * a key, without copying it.
+ * 
+ * The pointer remains valid until the map is changed.
+ * 
+ * @param map [in] pointer to the map
+ * @param key [in] key for retrieval
+ * 
+ * @return pointer to the value, or
+ * @return NULL if 'key' doesn't exist or 'map' is NULL
+ */
+const MapValue* mapGetRef(PtMap map, MapKey key);
+
+/**
+ * @brief Retrieves a read-only pointer to the value at an index of a map
+ * (see mapIndexOf), without copying it.
+ * 
+ * The pointer remains valid until the map is changed.
+ * 
+ * @param map [in] pointer to the map
+ * @param index [in] index of the value
+ * 
+ * @return pointer to the value, or
+ * @return NULL if 'index' is out of bounds or 'map' is NULL
+ */
+const MapValue* mapGetAtRef(PtMap map, int index);
+
+/**
+ * @brief Positions an iterator before the first pair of a map.
+ * 
+ * @param map [in] pointer to the map
+ * @param it [out] iterator to initialize
+ * 
+ * @return MAP_OK if successful, or
+ * @return MAP_NULL if 'map' or 'it' is NULL 
+ */
+int mapIterator(PtMap map, MapIterator *it);
+
+/**
+ * @brief Advances an iterator.
+ * 
+ * @param it [in] the iterator
+ * @param ptKey [out] address of variable to hold the key (may be NULL)
+ * @param ptValue [out] address of variable to hold a read-only pointer to the value (may be NULL)
+ * 
+ * @return 'true' if a pair was retrieved, or
+ * @return 'false' if every pair was visited
+ */
+bool mapIteratorNext(MapIterator *it, MapKey *ptKey, const MapValue **ptValue);
+
 /**
  * @brief Retrieves the set of keys of a map.
  * 
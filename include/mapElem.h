@@ -48,4 +48,14 @@ typedef Host MapValue;
  * @param key2 The second key to compare.
  * @return True if the keys are equal, False otherwise.
  */
-bool mapKeyEquals(MapKey key1, MapKey key2);
\ No newline at end of file
+bool mapKeyEquals(MapKey key1, MapKey key2);
+
+/**
+ * @brief Computes the hash of a map key.
+ * 
+ * Keys that are equal according to mapKeyEquals must have the same hash.
+ * 
+ * @param key The key to hash.
+ * @return The hash of the key.
+ */
+unsigned int mapKeyHash(MapKey key);
\ No newline at end of file
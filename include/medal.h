@@ -11,6 +11,9 @@
  */
 #pragma once
 
+#include "stringPool.h"
+#include "outputBuffer.h"
+
 #define MAX_DISC_LENGTH 50     ///< Maximum length for discipline names.
 #define MAX_GAME_LENGTH 50     ///< Maximum length for game names.
 #define MAX_EVENT_LENGTH 100   ///< Maximum length for event titles.
@@ -18,22 +21,90 @@
 #define MAX_COUNTRY_LENGTH 50  ///< Maximum length for country names.
 #define MAX_GENDER 20          ///< Maximum length for gender description.
 
+/**
+ * Text fields of a medal that are stored as codes into a shared dictionary.
+ * There are only a few hundred distinct values of each, so every distinct
+ * string is kept once and two medals have equal values exactly when they
+ * have equal codes.
+ */
+typedef enum medalField {
+    MEDAL_DISCIPLINE,   ///< Medal.discipline
+    MEDAL_GAME,         ///< Medal.game
+    MEDAL_EVENT,        ///< Medal.eventTitle
+    MEDAL_GENDER,       ///< Medal.gender
+    MEDAL_COUNTRY,      ///< Medal.country
+    MEDAL_FIELD_COUNT   ///< Number of dictionaries.
+} MedalField;
+
+#define MEDAL_EMPTY_CODE 0  ///< Code of the empty string in every dictionary, so a zeroed medal has empty text fields.
+
 typedef struct medal {
-    char discipline[MAX_DISC_LENGTH];   ///< Discipline of the competition.
-    char game[MAX_GAME_LENGTH];         ///< Name of the game (e.g., Olympics 2020).
-    char eventTitle[MAX_EVENT_LENGTH];  ///< Specific event title.
-    char gender[MAX_GENDER];            ///< Gender category of the event.
+    int discipline;                     ///< Code of the discipline of the competition.
+    int game;                           ///< Code of the name of the game (e.g., Olympics 2020).
+    int eventTitle;                     ///< Code of the specific event title.
+    int gender;                         ///< Code of the gender category of the event.
     char medalType;                     ///< Type of medal ('G' for Gold, 'S' for Silver, 'B' for Bronze).
     char participantType;               ///< Type of participant ('A' for athlete, 'T' for team).
     char athleteID[MAX_ID_LENGTH];      ///< Unique identifier for the athlete.
-    char country[MAX_COUNTRY_LENGTH];   ///< Country the athlete represents.
+    int country;                        ///< Code of the country the athlete represents.
+    int hostIndex;                      ///< Index of the host of the game in the hosts map, or -1 if not linked.
 } Medal;
 
+/**
+ * @brief Returns the code of a value of a medal field, adding it to the dictionary if needed.
+ * 
+ * Codes are never reassigned, so medals keep their meaning across imports.
+ * The dictionaries must not be modified by two threads at the same time.
+ * 
+ * @param field The field the value belongs to.
+ * @param value The value to intern.
+ * @return The code of the value, or STRING_POOL_NO_CODE if memory allocation fails.
+ */
+int medalIntern(MedalField field, const char *value);
+
+/**
+ * @brief Returns the code of a value of a medal field without adding it.
+ * 
+ * Useful to turn a search string into a code once: when the value is not in
+ * the dictionary, no medal has it.
+ * 
+ * @param field The field the value belongs to.
+ * @param value The value to find.
+ * @return The code of the value, or STRING_POOL_NO_CODE if no medal has that value.
+ */
+int medalCode(MedalField field, const char *value);
+
+/**
+ * @brief Returns the text of a code of a medal field.
+ * 
+ * @param field The field the code belongs to.
+ * @param code The code.
+ * @return The text, or an empty string if the code is not valid.
+ */
+const char* medalString(MedalField field, int code);
+
+/**
+ * @brief Returns the number of distinct values of a medal field.
+ * 
+ * @param field The field.
+ * @return Number of values, the valid codes being [0, count).
+ */
+int medalStringCount(MedalField field);
+
+/**
+ * @brief Returns the address of the code a medal holds for a text field.
+ * 
+ * @param medal The medal.
+ * @param field The field.
+ * @return Address of the code inside 'medal'.
+ */
+int* medalFieldCode(Medal *medal, MedalField field);
+
 /**
  * @brief Creates and initializes a new Medal object.
  * 
  * Allocates memory for a new Medal and sets its properties based on the provided parameters.
- * Strings are copied safely to avoid buffer overflows.
+ * The text fields are interned and the athlete ID is copied safely to avoid buffer overflows.
  * 
  * @param discipline Name of the discipline.
  * @param event Title of the event.
@@ -65,3 +136,10 @@ Medal* createEmptyMedal();
  * @param medal The Medal to print.
  */
 void printMedal(Medal medal);
+
+/**
+ * @brief Appends the details of a Medal to an output buffer, as printMedal prints them.
+ * @param out The buffer.
+ * @param medal The Medal to print.
+ */
+void formatMedal(OutputBuffer *out, const Medal *medal);
@@ -0,0 +1,72 @@
+/**
+ * @file medalFilter.h
+ * @brief Header file for the medal filter pipeline.
+ *
+ * A MedalFilter describes a conjunction of optional predicates over medals
+ * (year range and season of the game, game, discipline, gender, medal type and
+ * country). Each predicate is evaluated over its column of the list of medals
+ * by a vectorized kernel, and the matches are returned as row numbers or as a
+ * bitmap, so no medal is copied. Host based predicates are resolved once per
+ * host, and each medal reaches its host through Medal.hostIndex.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "listMedal.h"
+#include "map.h"
+
+#define FILTER_ANY_YEAR 0  ///< Value of startYear/endYear that disables that bound.
+
+/**
+ * Predicates a medal must satisfy. Unset predicates (NULL strings, '\0' medal
+ * type, FILTER_ANY_YEAR) match every medal.
+ */
+typedef struct medalFilter {
+    int startYear;           ///< Games must start in this year or later.
+    int endYear;             ///< Games must end in this year or earlier.
+    const char *season;      ///< Season of the games (e.g., "Summer").
+    const char *game;        ///< Slug of the game (e.g., "tokyo-2020").
+    const char *discipline;  ///< Discipline of the medal.
+    const char *gender;      ///< Gender category of the event (e.g., "Women").
+    char medalType;          ///< Type of medal ('G', 'S' or 'B').
+    const char *country;     ///< Country the medal was won for.
+} MedalFilter;
+
+/**
+ * @brief Initializes a filter that matches every medal.
+ * @param filter The filter to initialize.
+ */
+void medalFilterInit(MedalFilter *filter);
+
+/**
+ * @brief Checks if a filter needs the hosts of the games (year range or season).
+ * @param filter The filter to check.
+ * @return True if the filter has host based predicates, false otherwise.
+ */
+bool medalFilterUsesHosts(const MedalFilter *filter);
+
+/**
+ * @brief Evaluates a filter over a list of medals and returns the matching rows.
+ * When the filter uses hosts, medals must be linked to 'hosts' (see linkMedalHosts),
+ * and medals without a host never match.
+ * @param filter The predicates to evaluate.
+ * @param medals The medals to filter.
+ * @param hosts Mapping of game identifiers to hosts (may be NULL if not used by the filter).
+ * @param ptCount Pointer to store the number of matching rows.
+ * @return Array with the matching rows in ascending order (to be freed by the caller),
+ * or NULL on memory allocation failure.
+ */
+int* medalFilterRows(const MedalFilter *filter, PtListMedal medals, PtMap hosts, int *ptCount);
+
+/**
+ * @brief Evaluates a filter over a list of medals and returns a bitmap of the matches.
+ * Bit (row % 64) of word (row / 64) is set when the medal at that row matches.
+ * Host based predicates have the same requirements as in medalFilterRows.
+ * @param filter The predicates to evaluate.
+ * @param medals The medals to filter.
+ * @param hosts Mapping of game identifiers to hosts (may be NULL if not used by the filter).
+ * @param ptCount Pointer to store the number of matching rows.
+ * @return Bitmap of (size + 63) / 64 words (to be freed by the caller), or NULL on memory allocation failure.
+ */
+uint64_t* medalFilterBitmap(const MedalFilter *filter, PtListMedal medals, PtMap hosts, int *ptCount);
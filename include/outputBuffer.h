@@ -0,0 +1,86 @@
+/**
+ * @file outputBuffer.h
+ * @brief Header file for the buffered output of reports and tables.
+ *
+ * An OutputBuffer collects formatted text in one preallocated block and
+ * hands it to the operating system with a single write(2) when flushed, so a
+ * whole page or report costs one system call instead of one per line. Text
+ * printed with stdio before a flush is written first, which keeps the order
+ * of the output when both are mixed.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define OUTPUT_BUFFER_CAPACITY 65536  ///< Default capacity of a buffer, in bytes.
+#define OUTPUT_RECORD_CAPACITY 512    ///< Capacity of a block that holds the details of one record, see outputInitBlock.
+
+#define ANSI_CLEAR_SCREEN "\033[H\033[2J\033[3J"  ///< Moves the cursor home and clears the screen and the scrollback.
+
+/**
+ * Text waiting to be written to the standard output. Lives on the caller's
+ * stack; the text itself is kept in a block allocated by outputInit or
+ * provided by the caller to outputInitBlock.
+ */
+typedef struct outputBuffer {
+    char *data;       ///< The text, or NULL if it could not be allocated (text is then printed directly).
+    size_t length;    ///< Number of bytes of text.
+    size_t capacity;  ///< Size of 'data'.
+    bool owned;       ///< True if 'data' was allocated by the buffer and is freed with it.
+} OutputBuffer;
+
+/**
+ * @brief Initializes an empty buffer.
+ *
+ * If the memory cannot be allocated the buffer still works, printing the
+ * text directly with stdio.
+ *
+ * @param out The buffer.
+ * @param capacity Size of the block to allocate, e.g., OUTPUT_BUFFER_CAPACITY.
+ */
+void outputInit(OutputBuffer *out, size_t capacity);
+
+/**
+ * @brief Initializes an empty buffer that keeps its text in a block of the caller.
+ *
+ * Nothing is allocated, which suits short texts such as the details of one
+ * record printed from a stack array of OUTPUT_RECORD_CAPACITY bytes. The
+ * block must outlive the buffer; text larger than the block is moved to an
+ * allocated one.
+ *
+ * @param out The buffer.
+ * @param block The block that receives the text.
+ * @param capacity Size of 'block'.
+ */
+void outputInitBlock(OutputBuffer *out, char *block, size_t capacity);
+
+/**
+ * @brief Appends formatted text to a buffer, like printf.
+ *
+ * When the text does not fit, the buffer is flushed first, and grown if the
+ * text alone is larger than its capacity.
+ *
+ * @param out The buffer.
+ * @param format The format string, followed by its arguments.
+ */
+void outputPrintf(OutputBuffer *out, const char *format, ...);
+
+/**
+ * @brief Appends the ANSI sequence that clears the terminal to a buffer.
+ * @param out The buffer.
+ */
+void outputClearScreen(OutputBuffer *out);
+
+/**
+ * @brief Writes the text of a buffer to the standard output and empties it.
+ * @param out The buffer.
+ * @return True if successful, false if the text could not be written.
+ */
+bool outputFlush(OutputBuffer *out);
+
+/**
+ * @brief Flushes a buffer and frees the memory it allocated.
+ * @param out The buffer.
+ */
+void outputFree(OutputBuffer *out);
@@ -0,0 +1,64 @@
+/**
+ * @file snapshot.h
+ * @brief Header file for the binary snapshots of imported data.
+ *
+ * After a successful import, the loaded records are written to a compact,
+ * versioned binary file next to the CSV they came from. On the next start the
+ * snapshot is memory-mapped and loaded directly, skipping the CSV parsing,
+ * as long as the CSV file still has the same size and modification time.
+ * Stale, truncated or corrupt snapshots are rejected so callers can fall back
+ * to the CSV file.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include "list.h"
+#include "listMedal.h"
+#include "map.h"
+
+#define SNAPSHOT_VERSION 8  ///< Incremented whenever the layout of a snapshot or of its records changes.
+
+/**
+ * @brief Writes a snapshot of a list of athletes.
+ * @param athletes The athletes to save.
+ * @param sourcePath Path of the CSV file the athletes were imported from.
+ * @return True if the snapshot was written, false otherwise.
+ */
+bool snapshotSaveAthletes(PtList athletes, const char *sourcePath);
+
+/**
+ * @brief Loads a list of athletes from its snapshot.
+ * @param sourcePath Path of the CSV file the snapshot was made from.
+ * @return A list of athletes, or NULL if there is no valid, up-to-date snapshot.
+ */
+PtList snapshotLoadAthletes(const char *sourcePath);
+
+/**
+ * @brief Writes a snapshot of a list of medals.
+ * @param medals The medals to save.
+ * @param sourcePath Path of the CSV file the medals were imported from.
+ * @return True if the snapshot was written, false otherwise.
+ */
+bool snapshotSaveMedals(PtListMedal medals, const char *sourcePath);
+
+/**
+ * @brief Loads a list of medals from its snapshot.
+ * @param sourcePath Path of the CSV file the snapshot was made from.
+ * @return A list of medals, or NULL if there is no valid, up-to-date snapshot.
+ */
+PtListMedal snapshotLoadMedals(const char *sourcePath);
+
+/**
+ * @brief Writes a snapshot of a map of hosts.
+ * @param hosts The hosts to save.
+ * @param sourcePath Path of the CSV file the hosts were imported from.
+ * @return True if the snapshot was written, false otherwise.
+ */
+bool snapshotSaveHosts(PtMap hosts, const char *sourcePath);
+
+/**
+ * @brief Loads a map of hosts from its snapshot.
+ * @param sourcePath Path of the CSV file the snapshot was made from.
+ * @return A map of hosts, or NULL if there is no valid, up-to-date snapshot.
+ */
+PtMap snapshotLoadHosts(const char *sourcePath);
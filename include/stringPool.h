@@ -0,0 +1,62 @@
+/**
+ * @file stringPool.h
+ * @brief Definition of the ADT StringPool in C.
+ *
+ * A string pool interns strings: each distinct string is stored once and
+ * identified by a small integer code, assigned in order of first insertion
+ * (0, 1, 2, ...). Codes never change and strings are never removed, so a code
+ * stays valid, and the string it refers to stays at the same address, for the
+ * lifetime of the pool.
+ */
+#pragma once
+
+#define STRING_POOL_NO_CODE -1  ///< Returned when a string is not in the pool or cannot be added.
+
+/** Forward declaration of the data structure. */
+struct stringPoolImpl;
+
+/** Definition of pointer to the data structure. */
+typedef struct stringPoolImpl *PtStringPool;
+
+/**
+ * @brief Creates a new empty string pool.
+ * @return PtStringPool pointer to allocated data structure, or NULL if unsufficient memory.
+ */
+PtStringPool stringPoolCreate();
+
+/**
+ * @brief Frees a string pool and every string it holds.
+ * @param ptPool ADDRESS OF pointer to the pool (set to NULL).
+ */
+void stringPoolDestroy(PtStringPool *ptPool);
+
+/**
+ * @brief Returns the code of a string, adding it to the pool if it is not there yet.
+ * @param pool The pool.
+ * @param str The string to intern.
+ * @return The code of the string, or STRING_POOL_NO_CODE on memory allocation failure.
+ */
+int stringPoolIntern(PtStringPool pool, const char *str);
+
+/**
+ * @brief Returns the code of a string without adding it to the pool.
+ * @param pool The pool.
+ * @param str The string to find.
+ * @return The code of the string, or STRING_POOL_NO_CODE if it is not in the pool.
+ */
+int stringPoolFind(PtStringPool pool, const char *str);
+
+/**
+ * @brief Returns the string identified by a code.
+ * @param pool The pool.
+ * @param code The code of the string.
+ * @return The string, or NULL if the code is not valid.
+ */
+const char* stringPoolGet(PtStringPool pool, int code);
+
+/**
+ * @brief Returns the number of distinct strings in the pool.
+ * @param pool The pool.
+ * @return Number of strings, the valid codes being [0, size).
+ */
+int stringPoolSize(PtStringPool pool);
@@ -11,13 +11,13 @@
  */
 #pragma once
 
+#include <stdbool.h>
 #include "athlete.h"
 #include "medal.h"
 
 #define MAX_TOP_COUNTRY_LENGTH 50
 #define MAX_ATHLETE_NAME_LENGTH 100
 #define MAX_GAME_LENGTH 50
-#define MAX_MEDALS_GAME_LENGTH 50
 
 /**
  * @brief Structure to store medals won by an athlete in a specific game.
@@ -34,11 +34,29 @@ typedef struct topAthlete {
     char athlete[MAX_ID_LENGTH];
     char country[MAX_TOP_COUNTRY_LENGTH];
     int totalMedals;
-    MedalsPerGame medalsPerGame[MAX_MEDALS_GAME_LENGTH];
+    MedalsPerGame *medalsPerGame;  ///< Medals per game, in order of first medal.
     int medalsPerGameSize;
-    int daysPlayed;
+    int medalsPerGameCapacity;
+    int daysPlayed;                ///< Sum of the duration of every distinct game.
 } TopAthlete;
 
+/**
+ * @brief Structure to hold the result of a top N query, ready to be printed or exported.
+ */
+typedef struct topNResult {
+    TopAthlete *athletes;  ///< Athletes ordered by total medals (descending), then by ID.
+    int count;             ///< Number of athletes in the result.
+} TopNResult;
+
+/**
+ * @brief Initializes an empty top athlete record.
+ * 
+ * @param top Pointer to the TopAthlete structure to initialize.
+ * @param athleteID ID of the athlete.
+ * @param country Country the athlete represented.
+ */
+void initTopAthlete(TopAthlete *top, const char *athleteID, const char *country);
+
 /**
  * @brief Retrieves the medals record for a specific game.
  * 
@@ -49,14 +67,23 @@ typedef struct topAthlete {
  * @param game String representing the game to search for.
  * @return Pointer to the MedalsPerGame structure if found, NULL otherwise.
  */
-MedalsPerGame* getMedalsPerGame(TopAthlete *top, char *game);
+MedalsPerGame* getMedalsPerGame(TopAthlete *top, const char *game);
 
 /**
  * @brief Adds a record of medals for a game to a top athlete's list.
  * 
- * This function appends a new MedalsPerGame entry to the athlete's record.
+ * This function appends a new MedalsPerGame entry to the athlete's record,
+ * growing the list as needed.
  * 
  * @param top Pointer to the TopAthlete structure where the entry will be added.
  * @param medalsPerGame The MedalsPerGame structure to add.
+ * @return True if the entry was added, false on memory allocation failure.
+ */
+bool addMedalsPerGame(TopAthlete *top, MedalsPerGame medalsPerGame);
+
+/**
+ * @brief Frees a top N result and every athlete record it holds.
+ * 
+ * @param ptResult Address of the pointer to the result, set to NULL afterwards.
  */
-void addMedalsPerGame(TopAthlete *top, MedalsPerGame medalsPerGame);
\ No newline at end of file
+void destroyTopNResult(TopNResult **ptResult);
\ No newline at end of file
@@ -0,0 +1,27 @@
+#!/bin/sh
+
+# Builds one of the benchmark drivers in scripts/bench against the objects of
+# the program and runs it from the current directory (which must hold data/).
+# You must compile the program beforehand:
+# $> make
+#
+# Usage: scripts/bench.sh <driver> [arguments]
+# $> scripts/bench.sh csvParse data/medals.csv
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <driver> [arguments]"
+    echo "Drivers: $(ls "$(dirname "$0")"/bench | sed 's/\.c$//' | tr '\n' ' ')"
+    exit 1
+fi
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+NAME=$1
+shift
+
+mkdir -p "$ROOT/bin"
+gcc -Wall -I"$ROOT/include" -pthread -o "$ROOT/bin/bench_$NAME" "$ROOT/scripts/bench/$NAME.c" \
+    $(ls "$ROOT"/obj/*.o | grep -v '/main\.o$')
+
+"$ROOT/bin/bench_$NAME" "$@"
@@ -0,0 +1,412 @@
+/**
+ * @file csvParse.c
+ * @brief Benchmark of the CSV reader: tokenizing and dispatching the fields of every row.
+ *
+ * For each file, three passes are timed (best of a few rounds):
+ * - tokenize: csvNextRecord over the whole file.
+ * - ladder: every field goes through the else-if chain of strcmp against the
+ *   literal column names that the importers ran for each token when they read
+ *   the files with fgets and strtok.
+ * - table: the header is resolved once with csvResolveColumns and every row is
+ *   dispatched with csvApplyRecord, as the importers do now.
+ * Both dispatching passes copy each field into a null terminated token, as
+ * strtok returned it, and then store it with the same conversions, so they
+ * differ only in how the column is found.
+ *
+ * Usage: scripts/bench.sh csvParse [file.csv ...] (default: the three data files)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "csvReader.h"
+#include "helpers.h"
+#include "athlete.h"
+#include "medal.h"
+#include "host.h"
+
+#define MAX_COLUMNS 16
+#define MAX_HEADER_LENGTH 64
+#define MAX_TOKEN_LENGTH 256
+#define ROUNDS 5
+
+/**
+ * Medal with its text fields inline, as the importers filled it before the
+ * fields were interned into dictionaries.
+ */
+typedef struct textMedal {
+    char discipline[MAX_DISC_LENGTH];
+    char game[MAX_GAME_LENGTH];
+    char eventTitle[MAX_EVENT_LENGTH];
+    char gender[MAX_GENDER];
+    char medalType;
+    char participantType;
+    char athleteID[MAX_ID_LENGTH];
+    char country[MAX_COUNTRY_LENGTH];
+} TextMedal;
+
+/** Kind of file, told apart by the name of its first column. */
+typedef enum fileKind { FILE_ATHLETES, FILE_MEDALS, FILE_HOSTS, FILE_UNKNOWN } FileKind;
+
+static char headerNames[MAX_COLUMNS][MAX_HEADER_LENGTH];
+static char token[MAX_TOKEN_LENGTH];
+static Athlete athlete;
+static TextMedal medal;
+static Host host;
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void readToken(CsvField field) {
+    csvFieldCopy(field, token, MAX_TOKEN_LENGTH);
+}
+
+/* ------------------------------ Ladders ------------------------------ */
+
+static void ladderAthlete(const char *header) {
+    if(strcmp(header, "athlete_id") == 0) {
+        strcpy(athlete.athleteID, token);
+    }
+    else if(strcmp(header, "athlete_full_name") == 0) {
+        strcpy(athlete.athleteName, token);
+    }
+    else if(strcmp(header, "games_participations") == 0) {
+        athlete.gamesParticipations = atoi(token);
+    }
+    else if(strcmp(header, "first_game") == 0) {
+        athlete.yearFirstParticipation = getNumbersFromString(token);
+    }
+    else if(strcmp(header, "athlete_year_birth") == 0) {
+        if(strlen(token) == 0) athlete.athleteBirth = 0;
+        else athlete.athleteBirth = atoi(token);
+    }
+    else if(strcmp(header, "") != 0) {
+        printf("Invalid column %s\n", header);
+    }
+}
+
+static void ladderMedal(const char *header) {
+    if(strcmp(header, "discipline_title") == 0) {
+        strcpy(medal.discipline, token);
+    }
+    else if(strcmp(header, "slug_game") == 0) {
+        strcpy(medal.game, token);
+    }
+    else if(strcmp(header, "event_title") == 0) {
+        strcpy(medal.eventTitle, token);
+    }
+    else if(strcmp(header, "event_gender") == 0) {
+        strcpy(medal.gender, token);
+    }
+    else if(strcmp(header, "medal_type") == 0) {
+        if(strcmp(token, "GOLD") == 0) medal.medalType = 'G';
+        else if (strcmp(token, "SILVER") == 0) medal.medalType = 'S';
+        else if (strcmp(token, "BRONZE") == 0) medal.medalType = 'B';
+    }
+    else if(strcmp(header, "participant_type") == 0) {
+        if(strcmp(token, "Athlete") == 0) medal.participantType = 'A';
+        else if (strcmp(token, "GameTeam") == 0) medal.participantType = 'G';
+    }
+    else if(strcmp(header, "participant_title") == 0) {
+        // Not stored
+    }
+    else if(strcmp(header, "athlete_id") == 0) {
+        strcpy(medal.athleteID, token);
+    }
+    else if(strcmp(header, "country_name") == 0) {
+        strcpy(medal.country, token);
+    }
+    else if(strcmp(header, "country_3_letter_code") == 0) {
+        // Not stored
+    }
+    else if(strcmp(header, "") != 0) {
+        printf("Invalid column %s\n", header);
+    }
+
+    if(medal.participantType == 'A' && strlen(medal.athleteID) == 0)
+        strcpy(medal.athleteID, "UNKNOWN");
+}
+
+static void ladderHost(const char *header) {
+    if(strcmp(header, "game_slug") == 0) {
+        strcpy(host.gameSlug, token);
+    }
+    else if(strcmp(header, "game_end_date") == 0) {
+        strcpy(host.endDate, token);
+    }
+    else if(strcmp(header, "game_start_date") == 0) {
+        strcpy(host.startDate, token);
+    }
+    else if(strcmp(header, "game_location") == 0) {
+        strcpy(host.location, token);
+    }
+    else if(strcmp(header, "game_name") == 0) {
+        strcpy(host.gameName, token);
+    }
+    else if(strcmp(header, "game_season") == 0) {
+        strcpy(host.season, token);
+    }
+    else if(strcmp(header, "game_year") == 0) {
+        host.year = atoi(token);
+    }
+    else if(strcmp(header, "") != 0) {
+        printf("Invalid column %s\n", header);
+    }
+}
+
+/* --------------------------- Handler tables --------------------------- */
+
+static void tableAthleteId(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Athlete*)record)->athleteID, token);
+}
+
+static void tableAthleteName(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Athlete*)record)->athleteName, token);
+}
+
+static void tableAthleteParticipations(void *record, CsvField field) {
+    readToken(field);
+    ((Athlete*)record)->gamesParticipations = atoi(token);
+}
+
+static void tableAthleteFirstGame(void *record, CsvField field) {
+    readToken(field);
+    ((Athlete*)record)->yearFirstParticipation = getNumbersFromString(token);
+}
+
+static void tableAthleteBirth(void *record, CsvField field) {
+    readToken(field);
+    if(strlen(token) == 0) ((Athlete*)record)->athleteBirth = 0;
+    else ((Athlete*)record)->athleteBirth = atoi(token);
+}
+
+static const CsvColumn athleteColumns[] = {
+    { "athlete_id", tableAthleteId },
+    { "athlete_full_name", tableAthleteName },
+    { "games_participations", tableAthleteParticipations },
+    { "first_game", tableAthleteFirstGame },
+    { "athlete_year_birth", tableAthleteBirth }
+};
+
+static void tableMedalDiscipline(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((TextMedal*)record)->discipline, token);
+}
+
+static void tableMedalGame(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((TextMedal*)record)->game, token);
+}
+
+static void tableMedalEvent(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((TextMedal*)record)->eventTitle, token);
+}
+
+static void tableMedalGender(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((TextMedal*)record)->gender, token);
+}
+
+static void tableMedalType(void *record, CsvField field) {
+    readToken(field);
+    if(strcmp(token, "GOLD") == 0) ((TextMedal*)record)->medalType = 'G';
+    else if (strcmp(token, "SILVER") == 0) ((TextMedal*)record)->medalType = 'S';
+    else if (strcmp(token, "BRONZE") == 0) ((TextMedal*)record)->medalType = 'B';
+}
+
+static void tableMedalParticipantType(void *record, CsvField field) {
+    readToken(field);
+    if(strcmp(token, "Athlete") == 0) ((TextMedal*)record)->participantType = 'A';
+    else if (strcmp(token, "GameTeam") == 0) ((TextMedal*)record)->participantType = 'G';
+}
+
+static void tableMedalAthleteId(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((TextMedal*)record)->athleteID, token);
+}
+
+static void tableMedalCountry(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((TextMedal*)record)->country, token);
+}
+
+static const CsvColumn medalColumns[] = {
+    { "discipline_title", tableMedalDiscipline },
+    { "slug_game", tableMedalGame },
+    { "event_title", tableMedalEvent },
+    { "event_gender", tableMedalGender },
+    { "medal_type", tableMedalType },
+    { "participant_type", tableMedalParticipantType },
+    { "participant_title", NULL },
+    { "athlete_id", tableMedalAthleteId },
+    { "country_name", tableMedalCountry },
+    { "country_3_letter_code", NULL }
+};
+
+static void tableHostSlug(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Host*)record)->gameSlug, token);
+}
+
+static void tableHostEndDate(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Host*)record)->endDate, token);
+}
+
+static void tableHostStartDate(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Host*)record)->startDate, token);
+}
+
+static void tableHostLocation(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Host*)record)->location, token);
+}
+
+static void tableHostName(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Host*)record)->gameName, token);
+}
+
+static void tableHostSeason(void *record, CsvField field) {
+    readToken(field);
+    strcpy(((Host*)record)->season, token);
+}
+
+static void tableHostYear(void *record, CsvField field) {
+    readToken(field);
+    ((Host*)record)->year = atoi(token);
+}
+
+static const CsvColumn hostColumns[] = {
+    { "game_slug", tableHostSlug },
+    { "game_end_date", tableHostEndDate },
+    { "game_start_date", tableHostStartDate },
+    { "game_location", tableHostLocation },
+    { "game_name", tableHostName },
+    { "game_season", tableHostSeason },
+    { "game_year", tableHostYear }
+};
+
+/* ------------------------------- Passes ------------------------------- */
+
+/**
+ * @brief Tells the kind of a file from the name of its first column.
+ * @param header Name of the first column.
+ * @return The kind of file, or FILE_UNKNOWN.
+ */
+static FileKind fileKind(const char *header) {
+    if(strcmp(header, "athlete_id") == 0) return FILE_ATHLETES;
+    if(strcmp(header, "discipline_title") == 0) return FILE_MEDALS;
+    if(strcmp(header, "game_slug") == 0) return FILE_HOSTS;
+    return FILE_UNKNOWN;
+}
+
+/**
+ * @brief Runs one pass over a file.
+ * @param path The file.
+ * @param mode 0 = tokenize, 1 = ladder, 2 = table.
+ * @param ptRows Pointer to store the number of rows (header excluded).
+ * @return Elapsed seconds, -1 if the file cannot be read or -2 if it is not a data file.
+ */
+static double runPass(const char *path, int mode, long *ptRows) {
+    CsvReader reader;
+    if(!csvOpen(&reader, path)) return -1;
+
+    double start = now();
+
+    CsvField fields[MAX_COLUMNS];
+    int headerCount = csvNextRecord(&reader, fields, MAX_COLUMNS);
+    if(headerCount < 0) headerCount = 0;
+
+    for(int i = 0; i < headerCount; i++) csvFieldCopy(fields[i], headerNames[i], MAX_HEADER_LENGTH);
+
+    FileKind kind = headerCount > 0 ? fileKind(headerNames[0]) : FILE_UNKNOWN;
+    if(kind == FILE_UNKNOWN) {
+        csvClose(&reader);
+        return -2;
+    }
+
+    void *records[] = {&athlete, &medal, &host};
+    const CsvColumn *columns[] = {athleteColumns, medalColumns, hostColumns};
+    size_t recordSizes[] = {sizeof(Athlete), sizeof(TextMedal), sizeof(Host)};
+    int columnCounts[] = {
+        sizeof(athleteColumns) / sizeof(CsvColumn),
+        sizeof(medalColumns) / sizeof(CsvColumn),
+        sizeof(hostColumns) / sizeof(CsvColumn)
+    };
+
+    CsvFieldHandler handlers[MAX_COLUMNS];
+    csvResolveColumns(fields, headerCount, columns[kind], columnCounts[kind], handlers);
+
+    long rows = 0;
+    int count;
+    while((count = csvNextRecord(&reader, fields, MAX_COLUMNS)) != -1) {
+        rows++;
+
+        if(mode == 1) {
+            memset(records[kind], 0, recordSizes[kind]);
+
+            for(int i = 0; i < count && i < headerCount; i++) {
+                readToken(fields[i]);
+
+                if(kind == FILE_ATHLETES) ladderAthlete(headerNames[i]);
+                else if(kind == FILE_MEDALS) ladderMedal(headerNames[i]);
+                else ladderHost(headerNames[i]);
+            }
+        }
+        else if(mode == 2) {
+            memset(records[kind], 0, recordSizes[kind]);
+
+            csvApplyRecord(records[kind], fields, count, handlers, headerCount);
+
+            if(kind == FILE_MEDALS && medal.participantType == 'A' && strlen(medal.athleteID) == 0)
+                strcpy(medal.athleteID, "UNKNOWN");
+        }
+    }
+
+    double elapsed = now() - start;
+    csvClose(&reader);
+
+    *ptRows = rows;
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    const char *defaults[] = {"data/athletes.csv", "data/medals.csv", "data/hosts.csv"};
+    const char **paths = argc > 1 ? (const char**)argv + 1 : defaults;
+    int pathCount = argc > 1 ? argc - 1 : 3;
+
+    const char *modes[] = {"tokenize", "ladder", "table"};
+
+    for(int p = 0; p < pathCount; p++) {
+        for(int mode = 0; mode < 3; mode++) {
+            double best = -1;
+            long rows = 0;
+
+            for(int r = 0; r < ROUNDS; r++) {
+                double elapsed = runPass(paths[p], mode, &rows);
+                if(elapsed == -1) {
+                    printf("Could not open %s\n", paths[p]);
+                    return 1;
+                }
+                if(elapsed == -2) {
+                    printf("%s is not an athletes, medals or hosts file\n", paths[p]);
+                    return 1;
+                }
+                if(best < 0 || elapsed < best) best = elapsed;
+            }
+
+            printf("%-20s %-9s %9ld rows %9.2f ms %8.1f ns/row %7.2f Mrows/s\n", paths[p], modes[mode],
+                rows, best * 1e3, rows > 0 ? best * 1e9 / rows : 0, rows / best / 1e6);
+        }
+    }
+
+    return 0;
+}
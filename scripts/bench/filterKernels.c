@@ -0,0 +1,104 @@
+/**
+ * @file filterKernels.c
+ * @brief Benchmark of the predicate kernels, in rows per second for each instruction set.
+ *
+ * The columns are filled with random data shaped like the medal columns: codes
+ * in [0, CODE_COUNT) for the int kernels and medal types for the char kernel.
+ * Each kernel is timed (best of a few rounds) with every instruction set the
+ * processor supports, forced with kernelUseInstructionSet.
+ *
+ * Usage: scripts/bench.sh filterKernels [rows ...] (default: 1000000 10000000)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "filterKernels.h"
+
+#define ROUNDS 5
+#define CODE_COUNT 64
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Runs one kernel over the columns.
+ * @param kernel 0 = equalsInt, 1 = equalsChar, 2 = inSet.
+ * @param codes Column of codes.
+ * @param types Column of medal types.
+ * @param count Number of rows.
+ * @param set Membership of each code.
+ * @param bitmap Bitmap that receives the selection.
+ * @return Elapsed seconds.
+ */
+static double runKernel(int kernel, const int *codes, const char *types, int count, const int *set, uint64_t *bitmap) {
+    double start = now();
+
+    if(kernel == 0) kernelEqualsInt(codes, count, CODE_COUNT / 2, bitmap);
+    else if(kernel == 1) kernelEqualsChar(types, count, 'G', bitmap);
+    else kernelInSet(codes, count, set, CODE_COUNT, bitmap);
+
+    return now() - start;
+}
+
+int main(int argc, char **argv) {
+    int defaults[] = {1000000, 10000000};
+    int sizeCount = argc > 1 ? argc - 1 : 2;
+
+    const char *instructionSets[] = {"scalar", "sse2", "avx2"};
+    const char *kernels[] = {"eqInt", "eqChar", "inSet"};
+
+    int set[CODE_COUNT];
+    for(int c = 0; c < CODE_COUNT; c++) set[c] = c % 2;
+
+    printf("Selected by default: %s\n", kernelInstructionSet());
+    printf("%10s %-7s %8s %8s %8s (Mrows/s)\n", "rows", "set", kernels[0], kernels[1], kernels[2]);
+
+    srand(42);
+
+    for(int s = 0; s < sizeCount; s++) {
+        int count = argc > 1 ? atoi(argv[s + 1]) : defaults[s];
+        if(count <= 0) continue;
+
+        int *codes = malloc(count * sizeof(int));
+        char *types = malloc(count);
+        uint64_t *bitmap = malloc(BITMAP_WORDS(count) * sizeof(uint64_t));
+        if(codes == NULL || types == NULL || bitmap == NULL) {
+            printf("Not enough memory for %d rows\n", count);
+            return 1;
+        }
+
+        for(int i = 0; i < count; i++) {
+            codes[i] = rand() % CODE_COUNT;
+            types[i] = "GSB"[rand() % 3];
+        }
+
+        for(int is = 0; is < 3; is++) {
+            if(!kernelUseInstructionSet(instructionSets[is])) {
+                printf("%10d %-7s not supported\n", count, instructionSets[is]);
+                continue;
+            }
+
+            printf("%10d %-7s", count, instructionSets[is]);
+            for(int k = 0; k < 3; k++) {
+                double best = -1;
+
+                for(int r = 0; r < ROUNDS; r++) {
+                    double elapsed = runKernel(k, codes, types, count, set, bitmap);
+                    if(best < 0 || elapsed < best) best = elapsed;
+                }
+
+                printf(" %8.0f", count / best / 1e6);
+            }
+            printf("\n");
+        }
+
+        free(codes);
+        free(types);
+        free(bitmap);
+    }
+
+    return 0;
+}
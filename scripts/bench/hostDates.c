@@ -0,0 +1,104 @@
+/**
+ * @file hostDates.c
+ * @brief Benchmark of the host date fields: parsing the dates once versus at every visit.
+ *
+ * The hosts are imported and visited round-robin, as the filters and TOPN visit
+ * the host of each medal. Each visit checks a year range and reads the duration.
+ * Three passes are timed (best of a few rounds):
+ * - strings: the years and the duration are parsed from the date strings at every
+ *   visit with getYearFromDate and getDateDiffInDays, as the filters and TOPN did
+ *   before the hosts stored the parsed dates.
+ * - fields: the visit reads the numeric fields filled by computeHostDates.
+ * - compute: computeHostDates over every host, the cost paid once at import.
+ *
+ * Usage: scripts/bench.sh hostDates [visits] (default: 2000000)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "importFunctions.h"
+#include "helpers.h"
+#include "host.h"
+
+#define ROUNDS 5
+#define START_YEAR 1950
+#define END_YEAR 2000
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Runs one pass over the hosts.
+ * @param hosts The hosts.
+ * @param count Number of hosts.
+ * @param visits Number of visits (ignored by the compute pass, which visits each host once).
+ * @param mode 0 = strings, 1 = fields, 2 = compute.
+ * @param ptSum Pointer to store the sum of the durations of the hosts in range.
+ * @return Elapsed seconds.
+ */
+static double runPass(Host *hosts, int count, long visits, int mode, long *ptSum) {
+    long sum = 0;
+    double start = now();
+
+    if(mode == 2) {
+        for(int i = 0; i < count; i++) {
+            computeHostDates(&hosts[i]);
+            sum += hosts[i].duration;
+        }
+    }
+    else {
+        for(long v = 0; v < visits; v++) {
+            Host *host = &hosts[v % count];
+
+            if(mode == 0) {
+                if(getYearFromDate(host->startDate) >= START_YEAR && getYearFromDate(host->endDate) <= END_YEAR)
+                    sum += getDateDiffInDays(host->startDate, host->endDate);
+            }
+            else if(host->startYear >= START_YEAR && host->endYear <= END_YEAR) sum += host->duration;
+        }
+    }
+
+    double elapsed = now() - start;
+
+    *ptSum = sum;
+    return elapsed;
+}
+
+int main(int argc, char **argv) {
+    long visits = argc > 1 ? atol(argv[1]) : 2000000;
+
+    PtMap map = importHosts();
+    int count = 0;
+    if(map == NULL || mapSize(map, &count) != MAP_OK || count == 0) {
+        printf("Could not import the hosts\n");
+        return 1;
+    }
+
+    Host *hosts = malloc(count * sizeof(Host));
+    if(hosts == NULL) return 1;
+    for(int i = 0; i < count; i++) mapGetAt(map, i, &hosts[i]);
+
+    const char *modes[] = {"strings", "fields", "compute"};
+
+    for(int mode = 0; mode < 3; mode++) {
+        double best = -1;
+        long sum = 0;
+        long passVisits = mode == 2 ? count : visits;
+
+        for(int r = 0; r < ROUNDS; r++) {
+            double elapsed = runPass(hosts, count, visits, mode, &sum);
+            if(best < 0 || elapsed < best) best = elapsed;
+        }
+
+        printf("%-8s %9ld visits %9.2f ms %8.1f ns/visit (sum %ld)\n", modes[mode],
+            passVisits, best * 1e3, best * 1e9 / passVisits, sum);
+    }
+
+    free(hosts);
+    mapDestroy(&map);
+
+    return 0;
+}
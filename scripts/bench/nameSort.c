@@ -0,0 +1,74 @@
+/**
+ * @file nameSort.c
+ * @brief Benchmark of the name order of the athletes: radix on the name keys versus comparisons.
+ *
+ * The athletes are imported from data/athletes.csv and their name order is
+ * computed (best of a few rounds) in two ways:
+ * - compare: listSortedOrder without a key, an introsort with athleteCompareByName.
+ * - radix: listSortedOrder with athleteGetNameKey, a radix sort on the name keys
+ *   where only athletes with equal keys are compared, as orderAthletesAlphabetic does.
+ * Both orders are checked to be the same. The list caches one order at a time,
+ * so alternating the two sorts them again on every round.
+ *
+ * Usage: scripts/bench.sh nameSort (from a directory holding data/athletes.csv)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "importFunctions.h"
+#include "list.h"
+
+#define ROUNDS 5
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+int main() {
+    PtList athletes = importAthletes();
+    int size = 0;
+    if(athletes == NULL || listSize(athletes, &size) != LIST_OK || size == 0) {
+        printf("Could not import the athletes\n");
+        return 1;
+    }
+
+    const char *modes[] = {"compare", "radix"};
+    ListElemKey keys[] = {NULL, athleteGetNameKey};
+    double best[2] = {-1, -1};
+    int *orders[2];
+
+    for(int m = 0; m < 2; m++) {
+        orders[m] = malloc(size * sizeof(int));
+        if(orders[m] == NULL) return 1;
+    }
+
+    for(int r = 0; r < ROUNDS; r++) {
+        for(int m = 0; m < 2; m++) {
+            const int *order = NULL;
+
+            double start = now();
+            if(listSortedOrder(athletes, keys[m], athleteCompareByName, &order) != LIST_OK) {
+                printf("Not enough memory to sort the athletes\n");
+                return 1;
+            }
+            double elapsed = now() - start;
+
+            if(best[m] < 0 || elapsed < best[m]) best[m] = elapsed;
+            memcpy(orders[m], order, size * sizeof(int));
+        }
+    }
+
+    for(int m = 0; m < 2; m++)
+        printf("%-8s %9d athletes %9.2f ms %8.1f ns/athlete\n", modes[m], size, best[m] * 1e3, best[m] * 1e9 / size);
+
+    printf("Same order: %s\n", memcmp(orders[0], orders[1], size * sizeof(int)) == 0 ? "yes" : "no");
+
+    free(orders[0]);
+    free(orders[1]);
+    listDestroy(&athletes);
+
+    return 0;
+}
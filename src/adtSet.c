@@ -3,54 +3,151 @@
  * @brief Implementation file for the Set abstract data type.
  *
  * This file includes the implementation of functions to manipulate
- * sets that store elements of type Medal. It includes functions for
- * creating, managing, and manipulating these sets, as well as
- * detailed memory management to ensure efficient handling of set
- * capacities.
+ * sets that store elements of type Medal. Elements are kept in a dense
+ * array and indexed by an open-addressing hash table (linear probing)
+ * over the key extracted by the set's key function, so adding and
+ * looking up an element costs O(1) expected time.
  * @author Raul Rohjans
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "adtSet.h"
+#include "helpers.h"
 #include "medal.h"
 
+#define INITIAL_CAPACITY 10
+#define INITIAL_SLOTS 32 ///< Must be a power of two.
+
+#define EMPTY_SLOT -1    ///< Slot never used.
+#define DELETED_SLOT -2  ///< Slot whose element was removed.
+
 /**
  * Represents the implementation of an ADTSet
  */
 typedef struct AdtSetImpl {
     Medal *elements;
+    unsigned int *hashes;       ///< Hash of the key of each element.
     int size;
     int capacity;
+    int *slots;                 ///< Index into 'elements', EMPTY_SLOT or DELETED_SLOT.
+    int slotCount;              ///< Number of slots, always a power of two.
+    int usedSlots;              ///< Slots that are not EMPTY_SLOT.
+    SetKeyFunction keyFunction;
 } AdtSetImpl;
 
 /**
- * @brief Resizes the set to the new capacity.
+ * @brief Finds the slot holding the element with a given key.
+ * @param set The set to search.
+ * @param key Key of the element.
+ * @param hash Hash of 'key'.
+ * @return The slot of the element, or -1 if it is not in the set.
+ */
+static int findSlot(PtAdtSet set, const char *key, unsigned int hash) {
+    int mask = set->slotCount - 1;
+
+    for (int i = hash & mask; set->slots[i] != EMPTY_SLOT; i = (i + 1) & mask) {
+        int index = set->slots[i];
+        if (index < 0 || set->hashes[index] != hash) continue;
+
+        // Same hash, compare the actual keys
+        char elemKey[MAX_SET_KEY_LENGTH];
+        set->keyFunction(&set->elements[index], elemKey);
+
+        if (strcmp(elemKey, key) == 0) return i;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Places an element index in the first free slot of its probe chain.
+ * @param set The set.
+ * @param index Index of the element in 'elements'.
+ */
+static void insertSlot(PtAdtSet set, int index) {
+    int mask = set->slotCount - 1;
+
+    int i = set->hashes[index] & mask;
+    while (set->slots[i] >= 0) i = (i + 1) & mask;
+
+    if (set->slots[i] == EMPTY_SLOT) set->usedSlots++;
+    set->slots[i] = index;
+}
+
+/**
+ * @brief Rebuilds the slot table with a new number of slots, dropping deleted slots.
+ * @param set The set.
+ * @param slotCount New number of slots (power of two).
+ * @return True if successful, false on memory allocation failure.
+ */
+static bool rehash(PtAdtSet set, int slotCount) {
+    int *newSlots = (int*) malloc(slotCount * sizeof(int));
+    if (newSlots == NULL) return false;
+
+    free(set->slots);
+    set->slots = newSlots;
+    set->slotCount = slotCount;
+    set->usedSlots = 0;
+
+    for (int i = 0; i < slotCount; i++) set->slots[i] = EMPTY_SLOT;
+    for (int i = 0; i < set->size; i++) insertSlot(set, i);
+
+    return true;
+}
+
+/**
+ * @brief Resizes the element arrays of the set to the new capacity.
  * @param set Pointer to the set to be resized.
  * @param newCapacity The new capacity for the set.
+ * @return True if successful, false on memory allocation failure.
  */
-static void resizeSet(PtAdtSet set, int newCapacity) {
-    AdtSetImpl *setList = (AdtSetImpl *)set;
-    Medal *newElements = (Medal*) malloc(newCapacity * sizeof(Medal));
+static bool resizeSet(PtAdtSet set, int newCapacity) {
+    Medal *newElements = (Medal*) realloc(set->elements, newCapacity * sizeof(Medal));
+    if (newElements == NULL) return false;
+    set->elements = newElements;
+
+    unsigned int *newHashes = (unsigned int*) realloc(set->hashes, newCapacity * sizeof(unsigned int));
+    if (newHashes == NULL) return false;
+    set->hashes = newHashes;
 
-    for (int i = 0; i < setList->size; i++)
-        newElements[i] = setList->elements[i];
-        
-    free(setList->elements);
+    set->capacity = newCapacity;
 
-    setList->elements = newElements;
-    setList->capacity = newCapacity;
+    return true;
 }
 
 /**
- * @brief Creates a new set.
+ * @brief Creates a new set keyed by discipline, game and athlete.
  * @return Pointer to the newly created set.
  */
 PtAdtSet setCreate() {
-    AdtSetImpl *set = (AdtSetImpl*) malloc(sizeof(PtAdtSet));
+    return setCreateWithKey(setKeyMedal);
+}
+
+/**
+ * @brief Creates a new set with a specific key function.
+ * @param keyFunction Function that extracts the key of each Medal.
+ * @return Pointer to the newly created set, or NULL if memory allocation fails.
+ */
+PtAdtSet setCreateWithKey(SetKeyFunction keyFunction) {
+    AdtSetImpl *set = (AdtSetImpl*) malloc(sizeof(AdtSetImpl));
+    if (set == NULL) return NULL;
 
     set->size = 0;
-    set->capacity = 10;
+    set->capacity = INITIAL_CAPACITY;
     set->elements = (Medal*) malloc(set->capacity * sizeof(Medal));
+    set->hashes = (unsigned int*) malloc(set->capacity * sizeof(unsigned int));
+    set->slots = (int*) malloc(INITIAL_SLOTS * sizeof(int));
+    set->slotCount = INITIAL_SLOTS;
+    set->usedSlots = 0;
+    set->keyFunction = keyFunction != NULL ? keyFunction : setKeyMedal;
+
+    if (set->elements == NULL || set->hashes == NULL || set->slots == NULL) {
+        setDestroy(set);
+        return NULL;
+    }
+
+    for (int i = 0; i < INITIAL_SLOTS; i++) set->slots[i] = EMPTY_SLOT;
 
     return set;
 }
@@ -62,10 +159,46 @@ PtAdtSet setCreate() {
 void setDestroy(PtAdtSet set) {
     if (set == NULL) return;
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
+    free(set->elements);
+    free(set->hashes);
+    free(set->slots);
+    free(set);
+}
+
+/**
+ * @brief Key function that identifies a Medal by discipline, game and athlete.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyMedal(const Medal *elem, char *key) {
+    snprintf(key, MAX_SET_KEY_LENGTH, "%d\x1f%d\x1f%s", elem->discipline, elem->game, elem->athleteID);
+}
 
-    free(setList->elements);
-    free(setList);
+/**
+ * @brief Key function that identifies a Medal by its discipline only.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyDiscipline(const Medal *elem, char *key) {
+    snprintf(key, MAX_SET_KEY_LENGTH, "%d", elem->discipline);
+}
+
+/**
+ * @brief Key function that identifies a Medal by its game and discipline.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyGameDiscipline(const Medal *elem, char *key) {
+    snprintf(key, MAX_SET_KEY_LENGTH, "%d\x1f%d", elem->game, elem->discipline);
+}
+
+/**
+ * @brief Key function that identifies a Medal by its athlete.
+ * @param elem The Medal to extract the key from.
+ * @param key Buffer that receives the key.
+ */
+void setKeyAthlete(const Medal *elem, char *key) {
+    snprintf(key, MAX_SET_KEY_LENGTH, "%s", elem->athleteID);
 }
 
 /**
@@ -77,14 +210,28 @@ void setDestroy(PtAdtSet set) {
 bool setAdd(PtAdtSet set, Medal elem) {
     if(set == NULL) return false;
 
-    if (setContains(set, elem))
+    char key[MAX_SET_KEY_LENGTH];
+    set->keyFunction(&elem, key);
+    unsigned int hash = hashString(key);
+
+    if (findSlot(set, key, hash) != -1) return false;
+
+    // Keep the slot table at most 3/4 full, counting deleted slots
+    if ((set->usedSlots + 1) * 4 > set->slotCount * 3) {
+        int slotCount = set->slotCount;
+        while ((set->size + 1) * 2 > slotCount) slotCount *= 2;
+
+        if (!rehash(set, slotCount)) return false;
+    }
+
+    if (set->size == set->capacity && !resizeSet(set, 2 * set->capacity))
         return false;
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
-    if (setList->size == setList->capacity)
-        resizeSet(set, 2 * setList->capacity);
-    
-    setList->elements[setList->size++] = elem;
+    set->elements[set->size] = elem;
+    set->hashes[set->size] = hash;
+    insertSlot(set, set->size);
+    set->size++;
+
     return true;
 }
 
@@ -95,21 +242,35 @@ bool setAdd(PtAdtSet set, Medal elem) {
  * @return True if the Medal was removed successfully, false otherwise.
  */
 bool setRemove(PtAdtSet set, Medal elem) {
-    if(set == NULL) return false;
+    if(set == NULL || set->size == 0) return false;
+
+    char key[MAX_SET_KEY_LENGTH];
+    set->keyFunction(&elem, key);
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
+    int slot = findSlot(set, key, hashString(key));
+    if (slot == -1) return false;
 
-    for (int i = 0; i < setList->size; i++) {
-        if (setElemCompare(setList->elements[i], elem)) {
-            setList->elements[i] = setList->elements[--setList->size];
+    int index = set->slots[slot];
+    int last = set->size - 1;
+    set->slots[slot] = DELETED_SLOT;
 
-            if (setList->size > 0 && setList->size == setList->capacity / 4)
-                resizeSet(set, setList->capacity / 2);
-            
-            return true;
-        }
+    // Move the last element into the freed position and repoint its slot
+    if (index != last) {
+        char lastKey[MAX_SET_KEY_LENGTH];
+        set->keyFunction(&set->elements[last], lastKey);
+        int lastSlot = findSlot(set, lastKey, set->hashes[last]);
+
+        set->elements[index] = set->elements[last];
+        set->hashes[index] = set->hashes[last];
+        set->slots[lastSlot] = index;
     }
-    return false;
+
+    set->size--;
+
+    if (set->size > INITIAL_CAPACITY && set->size == set->capacity / 4)
+        resizeSet(set, set->capacity / 2);
+
+    return true;
 }
 
 /**
@@ -121,7 +282,7 @@ bool setRemove(PtAdtSet set, Medal elem) {
 bool setElemCompare(Medal elem1, Medal elem2) {
     if(elem1.discipline == elem2.discipline &&
         elem1.game == elem2.game &&
-        elem1.athleteID == elem2.athleteID) return true;
+        strcmp(elem1.athleteID, elem2.athleteID) == 0) return true;
     else return false;
 }
 
@@ -132,13 +293,12 @@ bool setElemCompare(Medal elem1, Medal elem2) {
  * @return True if the set contains the Medal, false otherwise.
  */
 bool setContains(PtAdtSet set, Medal elem) {
-    if(set == NULL) return false;
+    if(set == NULL || set->size == 0) return false;
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
-    for (int i = 0; i < setList->size; i++)
-        if (setElemCompare(setList->elements[i], elem)) return true;        
+    char key[MAX_SET_KEY_LENGTH];
+    set->keyFunction(&elem, key);
 
-    return false;
+    return findSlot(set, key, hashString(key)) != -1;
 }
 
 /**
@@ -149,8 +309,7 @@ bool setContains(PtAdtSet set, Medal elem) {
 int setSize(PtAdtSet set) {
     if(set == NULL) return 0;
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;    
-    return setList->size;
+    return set->size;
 }
 
 /**
@@ -161,10 +320,10 @@ int setSize(PtAdtSet set) {
  */
 bool setSubset(PtAdtSet subset, PtAdtSet set) {
     if(subset == NULL || set == NULL) return false;
+    if(subset->size > set->size && subset->keyFunction == set->keyFunction) return false;
 
-    AdtSetImpl *subsetList = (AdtSetImpl *)subset;
-    for (int i = 0; i < subsetList->size; i++)
-        if (!setContains(set, subsetList->elements[i])) return false;
+    for (int i = 0; i < subset->size; i++)
+        if (!setContains(set, subset->elements[i])) return false;
 
     return true;
 }
@@ -177,9 +336,7 @@ bool setSubset(PtAdtSet subset, PtAdtSet set) {
 bool setIsEmpty(PtAdtSet set) {
     if(set == NULL) return true;
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
-
-    return setList->size == 0;
+    return set->size == 0;
 }
 
 /**
@@ -189,28 +346,24 @@ bool setIsEmpty(PtAdtSet set) {
 void setClear(PtAdtSet set) {
     if(set == NULL) return;
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
-
-    free(setList->elements);
-
-    setList->size = 0;
-    resizeSet(set, 10);
+    set->size = 0;
+    resizeSet(set, INITIAL_CAPACITY);
+    rehash(set, INITIAL_SLOTS);
 }
 
 /**
  * @brief Retrieves an array of Medals stored in the set.
  * @param set The set whose elements are to be retrieved.
- * @return Pointer to an array of Medals. NULL if the set is empty.
+ * @return Pointer to an array of Medals, in insertion order. NULL if the set is empty.
  */
 Medal* setValues(PtAdtSet set) {
-    if(set == NULL) return NULL;
+    if(set == NULL || set->size == 0) return NULL;
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
-    Medal *values = (Medal*) malloc(setList->size * sizeof(Medal));
+    Medal *values = (Medal*) malloc(set->size * sizeof(Medal));
+    if (values == NULL) return NULL;
+
+    memcpy(values, set->elements, set->size * sizeof(Medal));
 
-    for (int i = 0; i < setList->size; i++)
-        values[i] = setList->elements[i];
-    
     return values;
 }
 
@@ -224,12 +377,14 @@ void setPrint(PtAdtSet set) {
         return;
     }
 
-    AdtSetImpl *setList = (AdtSetImpl *)set;
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
+    outputPrintf(&out, "----------------\n");
 
-    printf("----------------\n");
+    for (int i = 0; i < set->size; i++)
+        formatMedal(&out, &set->elements[i]);
 
-    for (int i = 0; i < setList->size; i++)
-        printMedal(setList->elements[i]);
-    
-    printf("----------------\n\n");
+    outputPrintf(&out, "----------------\n\n");
+    outputFree(&out);
 }
@@ -19,155 +19,117 @@
 #include "helpers.h"
 #include "topAthlete.h"
 #include "adtSet.h"
-
-#define MAX_PAGE_SIZE 20
+#include "medalFilter.h"
+#include "outputBuffer.h"
 
 /**
- * @brief Paginates and displays a list of athletes.
- * @param athletes The list of athletes to paginate.
+ * @brief Paginates and displays the athletes of a cursor, one page at a time.
+ * @param cursor Cursor opened with a page size of MAX_PAGE_SIZE.
  */
-void paginate(PtList athletes) {
-    int athletesCount = 0;
-    int currentPage = 1;
-        
-    listSize(athletes, &athletesCount);
-    if(athletesCount == 0) {
+void paginate(AthleteCursor *cursor) {
+    if(cursor->count == 0) {
         printf("No athletes were found.\n");
         return;
     }
     
+    const Athlete *rows[MAX_PAGE_SIZE];
+
+    // Each page is formatted whole and written at once
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
     char option = ' ';
-    Athlete ath;
     while(tolower(option) != 'q') {        
-        int endRecord = MAX_PAGE_SIZE * currentPage;
-        int startRecord = endRecord - MAX_PAGE_SIZE + 1;
-
-        // This means we have reached the end (aka last page)
-        if(endRecord > athletesCount) endRecord = athletesCount;
-
-        clearScreen();
-        printf("%d Atheletes were found!\n\n", athletesCount);
-        printf("+--------------------------------+-------------------------------------+----------------------+-----------------------------+---------------+\n");
-        printf("| Athlete ID                     | Athlete Name                        | Games Participations | Year of First Participation | Athlete Birth |\n");
-        printf("+--------------------------------+-------------------------------------+----------------------+-----------------------------+---------------+\n");
-
-        for(int i = startRecord-1; (i < athletesCount && athletesCount < endRecord) || (i < endRecord); i++) {            
-            if(listGet(athletes, i, &ath) != LIST_OK) {
-                printf("An error ocurred fetching records");
-                return;
-            }
-
-            printf("| %30s | %35s | %20d | %27d | %13d |\n", 
-                ath.athleteID, ath.athleteName, ath.gamesParticipations, ath.yearFirstParticipation, ath.athleteBirth);
-            printf("+--------------------------------+-------------------------------------+----------------------+-----------------------------+---------------+\n");
+        // Only the athletes of this page are visited
+        int rowCount = athleteCursorRows(cursor, rows);
+        int startRecord = cursor->page * MAX_PAGE_SIZE + 1;
+        int endRecord = startRecord + rowCount - 1;
+
+        outputClearScreen(&out);
+        outputPrintf(&out, "%d Atheletes were found!\n\n", cursor->count);
+        outputPrintf(&out, "+--------------------------------+-------------------------------------+----------------------+-----------------------------+---------------+\n");
+        outputPrintf(&out, "| Athlete ID                     | Athlete Name                        | Games Participations | Year of First Participation | Athlete Birth |\n");
+        outputPrintf(&out, "+--------------------------------+-------------------------------------+----------------------+-----------------------------+---------------+\n");
+
+        for(int i = 0; i < rowCount; i++) {            
+            const Athlete *ath = rows[i];
+
+            outputPrintf(&out, "| %30s | %35s | %20d | %27d | %13d |\n", 
+                ath->athleteID, ath->athleteName, ath->gamesParticipations, ath->yearFirstParticipation, ath->athleteBirth);
+            outputPrintf(&out, "+--------------------------------+-------------------------------------+----------------------+-----------------------------+---------------+\n");
         }
 
-        printf("\nDisplaying from %d to %d records. Total of %d records.\n", startRecord, endRecord, athletesCount);
-        printf("Press 'f' to go to next page, 'p' to go to previous or 'q' to quit.\n");
-        printf("Input -> ");
+        outputPrintf(&out, "\nDisplaying from %d to %d records. Total of %d records.\n", startRecord, endRecord, cursor->count);
+        outputPrintf(&out, "Press 'f' to go to next page, 'p' to go to previous or 'q' to quit.\n");
+        outputPrintf(&out, "Input -> ");
+        outputFlush(&out);
 
         fflush(stdin);
         scanf("%c", &option);
 
-        if(tolower(option) == 'f') {
-            if(endRecord < athletesCount) currentPage++;
-        }
-        else if(tolower(option) == 'p') {
-            if(currentPage > 1) currentPage--;
-        }
+        if(tolower(option) == 'f') athleteCursorNext(cursor);
+        else if(tolower(option) == 'p') athleteCursorPrevious(cursor);
         else if(tolower(option) == 'q') break;
     }
-}
 
-/**
- * @brief Sorts a list of athletes alphabetically by their names.
- * @param athletes Pointer to the list of athletes to be sorted.
- */
-void orderAthletesAlphabetic(PtList *athletes) {
-    if(athletes == NULL) return;
-    
-    int athCount = 0;
-    listSize(*athletes, &athCount);
-    quickSort(athletes, 0, athCount-1);
+    outputFree(&out);
 }
 
 /**
- * @brief Creates a shallow copy of a list of athletes.
- * @param athletes The original list of athletes.
- * @return A new list containing a shallow copy of the athletes.
+ * @brief Orders a list of athletes alphabetically by their names, ignoring case, without moving them.
+ * @param athletes The list of athletes.
+ * @return The ranks of the athletes in name order, owned by the list and valid until it changes, or NULL on failure.
  */
-PtList listAthleteShallowCopy(PtList athletes) {
-    int athleteCount = 0;
-    PtList list = listCreate();
-
-    listSize(athletes, &athleteCount);
-
-    for(int i = 0; i < athleteCount; i++) {
-        Athlete ath;
-        listGet(athletes, i, &ath);
+const int* orderAthletesAlphabetic(PtList athletes) {
+    const int *order = NULL;
+    if(listSortedOrder(athletes, athleteGetNameKey, athleteCompareByName, &order) != LIST_OK) return NULL;
 
-        listAdd(list, i, ath);
-    }
-
-    return list;
+    return order;
 }
 
 /**
  * @brief Filters athletes based on the number of participations.
- * @param athletes The list of athletes to filter.
+ * @param athlete The athlete to check.
  * @param participations Minimum number of participations to filter by.
- * @return A new list containing athletes who meet the criteria.
+ * @return True if the athlete participated at least that many times, false otherwise.
  */
-PtList filterAthletesPerParticipation(PtList athletes, int participations) {
-    if(athletes == NULL) return NULL;
-
-    PtList list = listCreate();
-
-    int athleteSize = 0;
-    listSize(athletes, &athleteSize);
-
-    for(int i = 0; i < athleteSize; i++) {
-        Athlete currrentAth;
-        listGet(athletes, i, &currrentAth);
-
-        if(currrentAth.gamesParticipations >= participations) {
-            int size = 0;
-            listSize(list, &size);
-
-            listAdd(list, size, currrentAth);
-        }
-    }
-
-    return list;
+bool filterAthletesPerParticipation(const Athlete *athlete, int participations) {
+    return athlete->gamesParticipations >= participations;
 }
 
 /**
  * @brief Filters athletes who first participated in a specific year.
- * @param athletes The list of athletes to filter.
+ * @param athlete The athlete to check.
  * @param year The year to filter by.
- * @return A new list containing athletes who first participated in the specified year.
+ * @return True if the athlete first participated in that year, false otherwise.
  */
-PtList filterAthletesPerFirstYear(PtList athletes, int year) {
-    if(athletes == NULL) return NULL;
-
-    PtList list = listCreate();
+bool filterAthletesPerFirstYear(const Athlete *athlete, int year) {
+    return athlete->yearFirstParticipation == year;
+}
 
-    int athleteSize = 0;
-    listSize(athletes, &athleteSize);
+/**
+ * @brief Prints the distinct values of a medal field, in order of first appearance.
+ * @param out Buffer that receives the text.
+ * @param label Label printed before the values.
+ * @param column Column of the text field in the list of medals (see listMedalColumns).
+ * @param rows Rows of the medals to print.
+ * @param count Number of rows.
+ * @param field The text field to print.
+ */
+static void printDistinctMedalField(OutputBuffer *out, const char *label, const int *column, const int *rows, int count, MedalField field) {
+    outputPrintf(out, "%s: ", label);
 
-    for(int i = 0; i < athleteSize; i++) {
-        Athlete currrentAth;
-        listGet(athletes, i, &currrentAth);
+    for(int i = 0; i < count; i++) {
+        int value = column[rows[i]];
 
-        if(currrentAth.yearFirstParticipation == year){
-            int size = 0;
-            listSize(list, &size);
+        // Athletes have few medals, a linear check is enough
+        bool seen = false;
+        for(int j = 0; j < i && !seen; j++) seen = column[rows[j]] == value;
 
-            listAdd(list, size, currrentAth);
-        }
+        if(!seen) outputPrintf(out, i == 0 ? "%s" : ", %s", medalString(field, value));
     }
 
-    return list;
+    outputPrintf(out, "\n");
 }
 
 /**
@@ -179,71 +141,49 @@ PtList filterAthletesPerFirstYear(PtList athletes, int year) {
 void showAthleteInfo(PtList athletes, PtListMedal medals, char *athleteID) {
 
     // Fetch corresponding athlete
-    Athlete filteredAths;
-    if(!getAthleteById(athletes, athleteID, &filteredAths)) {
+    Athlete athlete;
+    if(!getAthleteById(athletes, athleteID, &athlete)) {
         printf("Could not find an athlete with that ID.\n");
         return;
     }
 
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
+    formatAthlete(&out, &athlete);
+
     // Fetch corresponding medals
-    PtListMedal filteredMedals = getMedalsPerAthlete(medals, athleteID);
-    if(filteredMedals == NULL) {
-        printf("That athlete didn't earn any medals.\n");
+    const int *rows = NULL;
+    int medalCount = 0;
+    if(!getMedalsPerAthlete(medals, athleteID, &rows, &medalCount)) {
+        outputPrintf(&out, "That athlete didn't earn any medals.\n");
+        outputFree(&out);
         return;
     }
 
-    int medalSize = 0;
-    listMedalSize(filteredMedals, &medalSize);
-
-    // Gather info about the contries that the player
-    // represented, and slugs that he earned medals
-    char* countries = malloc(sizeof(char) * 250);
-    char* slugs = malloc(sizeof(char) * 250);    
-    for(int i = 0; i < medalSize; i++) {
-        Medal current;
-        listMedalGet(filteredMedals, i, &current);
+    // Countries the athlete represented and editions where medals were earned
+    MedalColumns columns;
+    listMedalColumns(medals, &columns);
 
-        // Countries
-        strcat(countries, current.country);
-        strcat(countries, ", ");
+    outputPrintf(&out, "Medals: %d\n", medalCount);
+    printDistinctMedalField(&out, "Countries", columns.country, rows, medalCount, MEDAL_COUNTRY);
+    printDistinctMedalField(&out, "Games", columns.game, rows, medalCount, MEDAL_GAME);
 
-        // Editions
-        strcat(slugs, current.game);
-        strcat(slugs, ", ");
-    }
-
-    free(countries);
-    free(slugs);
-    free(filteredMedals);
+    outputFree(&out);
 }
 
 /**
- * @brief Retrieves all medals won by a specific athlete.
+ * @brief Retrieves the medals won by a specific athlete, through the athlete index of the list.
  * @param medals The list of all medals.
  * @param athleteID The ID of the athlete to search for.
- * @return A new list containing all medals won by the specified athlete.
+ * @param ptRows Pointer to store the rows of the medals in 'medals', valid until the list changes.
+ * @param ptCount Pointer to store the number of medals.
+ * @return True if the athlete won at least one medal, false otherwise.
  */
-PtListMedal getMedalsPerAthlete(PtListMedal medals, char *athleteID) {
-    if(medals == NULL) return NULL;
-
-    PtList list = listMedalCreate();
-
-    int size = 0, subsize = 0;
-    listMedalSize(medals, &size);
+bool getMedalsPerAthlete(PtListMedal medals, char *athleteID, const int **ptRows, int *ptCount) {
+    if(listMedalRowsOfAthlete(medals, athleteID, ptRows, ptCount) != LIST_OK) return false;
 
-    for(int i = 0; i < size; i++) {
-        Medal medal;
-        listMedalGet(medals, i, &medal);
-
-        if(strcmp(medal.athleteID, athleteID) == 0) {
-            listMedalSize(medals, &subsize);
-            listMedalAdd(medals, subsize, medal);
-        }
-    }
-
-    if(subsize == 0) return NULL;
-
-    return list;
+    return *ptCount > 0;
 }
 
 /**
@@ -254,218 +194,326 @@ PtListMedal getMedalsPerAthlete(PtListMedal medals, char *athleteID) {
  * @return True if the athlete is found, false otherwise.
  */
 bool getAthleteById(PtList athletes, char *athleteID, Athlete* athlete) {
-    int size = 0;
-    listSize(athletes, &size);
+    int rank;
+    if(listFindById(athletes, athleteID, &rank) != LIST_OK) return false;
 
-    for(int i = 0; i < size; i++) {
-        listGet(athletes, i, athlete);
-
-        if(strcmp(athlete->athleteID, athleteID) == 0) return true;
-    }
-
-    athlete = NULL;
-    return false;
+    return listGet(athletes, rank, athlete) == LIST_OK;
 }
 
+#define UNKNOWN_ATHLETE -1  ///< Athlete ordinal not seen yet while aggregating.
+#define NOT_RANKED -2       ///< Athlete ordinal that is not in the list of athletes.
+
 /**
- * @brief Filters medals between specified start and end years.
- * @param startYear The starting year of the period.
- * @param endYear The ending year of the period.
- * @param medals The list of medals to filter.
- * @param hosts Mapping of game identifiers to hosts.
- * @return A list of medals that fall within the specified years.
+ * Running totals of one athlete while aggregating medals for a top N query.
+ * The rows of the athlete are chained through a 'next row' array so they
+ * can be revisited without storing a list per athlete.
  */
-PtListMedal filterMedalsPerDate(int startYear, int endYear, PtListMedal medals, PtMap hosts) {
-    if(medals == NULL) return NULL;
+typedef struct athleteTotal {
+    const char *athleteID;  ///< ID of the athlete, owned by the list of medals.
+    int totalMedals;
+    int firstRow;  ///< Position of the first medal of the athlete in the aggregated rows.
+    int lastRow;   ///< Position of the last medal of the athlete, where the chain is extended.
+} AthleteTotal;
 
-    int size = 0, lstSize = 0;
-    listMedalSize(medals, &size);
-    
-    PtListMedal list = listMedalCreate();
-    for(int i = 0; i < size; i++) {
-        Medal current;
-        listMedalGet(medals, i, &current);
+/**
+ * @brief Checks if an athlete ranks above another one (more medals, then lower ID).
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return True if 'a' ranks above 'b', false otherwise.
+ */
+static bool ranksAbove(const AthleteTotal *a, const AthleteTotal *b) {
+    if(a->totalMedals != b->totalMedals) return a->totalMedals > b->totalMedals;
 
-        // Get host
-        Host host;
-        mapGet(hosts, current.game, &host);
+    return strcmp(a->athleteID, b->athleteID) < 0;
+}
 
-        if(getYearFromDate(host.startDate) >= startYear && getYearFromDate(host.endDate) <= endYear) {
-            listMedalSize(list, &lstSize);
-            listMedalAdd(list, lstSize, current);
-        }        
+/**
+ * @brief Restores the heap property downwards in a min-heap of athlete totals.
+ * The root of the heap is the lowest ranked athlete kept so far.
+ * @param heap Heap of indexes into 'totals'.
+ * @param size Number of elements in the heap.
+ * @param i Position to sift down from.
+ * @param totals Athlete totals.
+ */
+static void siftDown(int *heap, int size, int i, const AthleteTotal *totals) {
+    while(true) {
+        int lowest = i, left = 2 * i + 1, right = 2 * i + 2;
+
+        if(left < size && ranksAbove(&totals[heap[lowest]], &totals[heap[left]])) lowest = left;
+        if(right < size && ranksAbove(&totals[heap[lowest]], &totals[heap[right]])) lowest = right;
+        if(lowest == i) return;
+
+        int tmp = heap[i];
+        heap[i] = heap[lowest];
+        heap[lowest] = tmp;
+        i = lowest;
     }
-
-    return list;
 }
 
 /**
- * @brief Filters medals by game type (e.g., Summer or Winter Olympics).
- * @param gameType The type of games to filter (e.g., "Summer").
- * @param medals The list of medals to filter.
- * @param hosts Mapping of game identifiers to hosts, which include the season.
- * @return A list of medals from the specified type of games.
+ * @brief Builds the full record of a selected athlete by walking its medal rows.
+ * @param top Record to fill.
+ * @param total Totals of the athlete.
+ * @param nextRow Chain of positions in 'rows' per athlete.
+ * @param columns Columns of the list of all medals.
+ * @param rows Rows of the medals that were aggregated.
+ * @param hosts Mapping of game identifiers to hosts.
+ * @return True if successful, false on memory allocation failure.
  */
-PtListMedal filterMedalsPerGameType(char *gameType, PtListMedal medals, PtMap hosts) {
-    if(medals == NULL) return NULL;
+static bool buildTopAthlete(TopAthlete *top, const AthleteTotal *total, const int *nextRow, const MedalColumns *columns, const int *rows, PtMap hosts) {
+    initTopAthlete(top, total->athleteID, medalString(MEDAL_COUNTRY, columns->country[rows[total->firstRow]]));
+    top->totalMedals = total->totalMedals;
+
+    for(int i = total->firstRow; i != -1; i = nextRow[i]) {
+        int row = rows[i];
+
+        const char *game = medalString(MEDAL_GAME, columns->game[row]);
+        MedalsPerGame *medalsPerGame = getMedalsPerGame(top, game);
+        if(medalsPerGame != NULL) {
+            medalsPerGame->medals++;
+            continue;
+        }
 
-    int size = 0, lstSize = 0;
-    listMedalSize(medals, &size);
-    
-    PtListMedal list = listMedalCreate();
-    for(int i = 0; i < size; i++) {
-        Medal current;
-        listMedalGet(medals, i, &current);
+        MedalsPerGame newMedalsPerGame;
+        strcpy(newMedalsPerGame.game, game);
+        newMedalsPerGame.medals = 1;
 
-        // Get host
-        Host host;
-        mapGet(hosts, current.game, &host);
+        if(!addMedalsPerGame(top, newMedalsPerGame)) return false;
 
-        if(strcmp(gameType, host.season) == 0) {
-            listMedalSize(list, &lstSize);
-            listMedalAdd(list, lstSize, current);
-        }        
+        // Days are counted once per game
+        const Host *host = mapGetAtRef(hosts, columns->hostIndex[row]);
+        if(host != NULL && host->duration > 0)
+            top->daysPlayed += host->duration;
     }
 
-    return list;
+    return true;
 }
 
 /**
- * @brief Displays statistics and information for the top N athletes.
- * @param n Number of top athletes to display.
- * @param startYear Start year of the period to consider.
- * @param endYear End year of the period to consider.
- * @param gameType Type of games (e.g., "Summer").
+ * @brief Computes the N athletes with most medals among some rows of a list of medals.
+ * @param n Number of athletes to select.
  * @param athletes List of all athletes.
- * @param medals List of all medals.
+ * @param medals The list of all medals.
+ * @param rows Rows of the medals to consider (e.g., from medalFilterRows).
+ * @param medalCount Number of rows.
  * @param hosts Mapping of game identifiers to hosts.
+ * @return The selected athletes, or NULL on memory allocation failure.
  */
-void showTopN(int n, int startYear, int endYear, char *gameType, PtList athletes, PtListMedal medals, PtMap hosts) {
-    if(athletes == NULL || medals == NULL || hosts == NULL) {
-        printf("Make sure athletes, medals and hosts have been imported!");
-        return;
+TopNResult* computeTopN(int n, PtList athletes, PtListMedal medals, const int *rows, int medalCount, PtMap hosts) {
+    if(n < 0) n = 0;
+
+    MedalColumns columns;
+    listMedalColumns(medals, &columns);
+
+    // Athletes are numbered by the list of medals, their totals are found by ordinal
+    int capacity = medalCount > 0 ? medalCount : 1;
+    int *totalOfAthlete = malloc((columns.athleteCount > 0 ? columns.athleteCount : 1) * sizeof(int));
+    int *nextRow = malloc(capacity * sizeof(int));
+    AthleteTotal *totals = malloc(capacity * sizeof(AthleteTotal));
+    TopNResult *result = calloc(1, sizeof(TopNResult));
+
+    if(totalOfAthlete == NULL || nextRow == NULL || totals == NULL || result == NULL) {
+        free(totalOfAthlete);
+        free(nextRow);
+        free(totals);
+        free(result);
+        return NULL;
     }
 
-    PtListMedal filteredMedals = filterMedalsPerDate(startYear, endYear, medals, hosts);
-    PtListMedal finalFilteredMedals = filterMedalsPerGameType(gameType, filteredMedals, hosts);
-    free(filteredMedals);
-
-
-    int athSize = 0, medalSize = 0;
-    listSize(athletes, &athSize);
-    listMedalSize(finalFilteredMedals, &medalSize);
+    for(int a = 0; a < columns.athleteCount; a++) totalOfAthlete[a] = UNKNOWN_ATHLETE;
 
-    
-    TopAthlete *topAthletes = malloc(sizeof(TopAthlete) * athSize);
-    int topAthletesCount = 0;
-    for(int i = 0; i < athSize; i++) {
-        Athlete currentAthlete;
-        listGet(athletes, i, &currentAthlete);
-        
-        bool found = false; // Use this thing to only create records for athletes with medals
-        for(int j = 0; j < medalSize; j++) {
-            Medal currentMedal;
-            listMedalGet(finalFilteredMedals, j, &currentMedal);
+    // Single pass: aggregate the medals of each athlete
+    int totalCount = 0;
+    for(int row = 0; row < medalCount; row++) {
+        int athlete = columns.athlete[rows[row]];
+        nextRow[row] = -1;
 
-            if(!found) {
-                topAthletes[topAthletesCount].totalMedals = 0;
+        if(totalOfAthlete[athlete] == UNKNOWN_ATHLETE) {
+            // Only athletes that exist are ranked (team medals have no athlete)
+            const char *athleteID = listMedalAthleteId(medals, athlete);
+            if(listFindById(athletes, athleteID, NULL) != LIST_OK) {
+                totalOfAthlete[athlete] = NOT_RANKED;
+                continue;
             }
 
-            if(strcmp(currentMedal.athleteID, currentAthlete.athleteID) == 0) {
-                found = true; 
+            AthleteTotal *total = &totals[totalCount];
+            total->athleteID = athleteID;
+            total->totalMedals = 0;
+            total->firstRow = row;
+            total->lastRow = row;
+            totalOfAthlete[athlete] = totalCount++;
+        }
+        else if(totalOfAthlete[athlete] == NOT_RANKED) continue;
+        else {
+            AthleteTotal *total = &totals[totalOfAthlete[athlete]];
+            nextRow[total->lastRow] = row;
+            total->lastRow = row;
+        }
 
-                // Add total medals
-                topAthletes[topAthletesCount].totalMedals++;
+        totals[totalOfAthlete[athlete]].totalMedals++;
+    }
 
-                // Add medals per game
-                MedalsPerGame *medalsPerGame = getMedalsPerGame(&topAthletes[topAthletesCount], currentMedal.game);
-                if(medalsPerGame == NULL) { // Create new
-                    MedalsPerGame *newMedalsPerGame = malloc(sizeof(MedalsPerGame));
-                    strcpy(newMedalsPerGame->game, currentMedal.game);
-                    newMedalsPerGame->medals = 1;
+    free(totalOfAthlete);
 
-                    addMedalsPerGame(&topAthletes[topAthletesCount], *newMedalsPerGame);
-                }
-                else { // Increment existent
-                    medalsPerGame->medals++;
-                }
+    // Bounded selection: keep the best N in a min-heap, replacing its root when beaten
+    int k = n < totalCount ? n : totalCount;
+    int *heap = malloc((k > 0 ? k : 1) * sizeof(int));
+    result->athletes = malloc((k > 0 ? k : 1) * sizeof(TopAthlete));
 
-                // Sum days played
-                Host currentHost;
-                mapGet(hosts, currentMedal.game, &currentHost);
+    if(heap == NULL || result->athletes == NULL) {
+        free(heap);
+        free(nextRow);
+        free(totals);
+        destroyTopNResult(&result);
+        return NULL;
+    }
 
-                topAthletes[topAthletesCount].daysPlayed = getDateDiffInDays(currentHost.startDate, currentHost.endDate);
-            }
+    int heapSize = 0;
+    for(int i = 0; k > 0 && i < totalCount; i++) {
+        if(heapSize < k) {
+            heap[heapSize++] = i;
+            if(heapSize == k)
+                for(int j = k / 2 - 1; j >= 0; j--) siftDown(heap, k, j, totals);
         }
-
-        if(found) {
-            strcpy(topAthletes[topAthletesCount].athlete, currentAthlete.athleteID);
-            topAthletesCount++;
+        else if(ranksAbove(&totals[i], &totals[heap[0]])) {
+            heap[0] = i;
+            siftDown(heap, k, 0, totals);
         }
     }
 
-    // Validate empty filtered athletes
-    if(topAthletesCount == 0) {
-        printf("There aren't any athletes that won any medals.\n");
-        return;
+    // Pop the lowest ranked athlete into the last free position, leaving the heap array in descending order
+    for(int size = k; size > 1; size--) {
+        int lowest = heap[0];
+        heap[0] = heap[size - 1];
+        siftDown(heap, size - 1, 0, totals);
+        heap[size - 1] = lowest;
     }
 
-    // Display information
-    for(int j = 0; (j < topAthletesCount && topAthletesCount < n) || (j < n); j++) {
-        printf("\n----------\n");
+    for(int j = 0; j < k; j++) {
+        if(!buildTopAthlete(&result->athletes[j], &totals[heap[j]], nextRow, &columns, rows, hosts)) {
+            // Keep the complete records only
+            free(result->athletes[j].medalsPerGame);
+            break;
+        }
 
-        printf("Athlete: %s\n", topAthletes[j].athlete);
+        result->count++;
+    }
 
-        printf("Participated Countries: \n");
-        for(int k = 0; k < topAthletes[j].medalsPerGameSize; k++) {
-            Host currentHost;
-            mapGet(hosts, topAthletes[j].medalsPerGame[k].game, &currentHost);
+    free(heap);
+    free(nextRow);
+    free(totals);
 
-            printf("- %s\n", currentHost.location);
+    return result;
+}
+
+/**
+ * @brief Prints the result of a top N query.
+ * @param result The selected athletes.
+ * @param hosts Mapping of game identifiers to hosts.
+ */
+void printTopN(const TopNResult *result, PtMap hosts) {
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
+    for(int j = 0; j < result->count; j++) {
+        const TopAthlete *top = &result->athletes[j];
+
+        outputPrintf(&out, "\n----------\n");
+
+        outputPrintf(&out, "Athlete: %s\n", top->athlete);
+        outputPrintf(&out, "Country: %s\n", top->country);
+
+        outputPrintf(&out, "Participated Countries: \n");
+        for(int k = 0; k < top->medalsPerGameSize; k++) {
+            const Host *currentHost = mapGetRef(hosts, top->medalsPerGame[k].game);
+            if(currentHost != NULL)
+                outputPrintf(&out, "- %s\n", currentHost->location);
         }
-        printf("\n");
+        outputPrintf(&out, "\n");
         
-        printf("Total Medals Earned: %d\n", topAthletes[j].totalMedals);
+        outputPrintf(&out, "Total Medals Earned: %d\n", top->totalMedals);
 
-        if(topAthletes[j].medalsPerGameSize == 0)
-            printf("Average Medals per Game: N/A (no medals per game)\n");
+        if(top->medalsPerGameSize == 0)
+            outputPrintf(&out, "Average Medals per Game: N/A (no medals per game)\n");
         else
-            printf("Average Medals per Game: %d\n", topAthletes[j].totalMedals / topAthletes[j].medalsPerGameSize);
+            outputPrintf(&out, "Average Medals per Game: %.2f\n", (double)top->totalMedals / top->medalsPerGameSize);
 
-        if(topAthletes[j].daysPlayed == 0)
-            printf("Average Medals per Day: N/A (No days played)\n");
+        if(top->daysPlayed == 0)
+            outputPrintf(&out, "Average Medals per Day: N/A (No days played)\n");
         else
-            printf("Average Medals per Day: %d\n", topAthletes[j].totalMedals / topAthletes[j].daysPlayed);
+            outputPrintf(&out, "Average Medals per Day: %.2f\n", (double)top->totalMedals / top->daysPlayed);
         
-        printf("----------\n");
+        outputPrintf(&out, "----------\n");
     }
 
-    free(finalFilteredMedals);
-    
-    // This thing throws an exception, no idea why
-    //free(topAthletes);
+    outputFree(&out);
+}
+
+/**
+ * @brief Displays statistics and information for the top N athletes.
+ * @param n Number of top athletes to display.
+ * @param startYear Start year of the period to consider.
+ * @param endYear End year of the period to consider.
+ * @param gameType Type of games (e.g., "Summer").
+ * @param athletes List of all athletes.
+ * @param medals List of all medals.
+ * @param hosts Mapping of game identifiers to hosts.
+ */
+void showTopN(int n, int startYear, int endYear, char *gameType, PtList athletes, PtListMedal medals, PtMap hosts) {
+    if(athletes == NULL || medals == NULL || hosts == NULL) {
+        printf("Make sure athletes, medals and hosts have been imported!");
+        return;
+    }
+
+    // Medals of the games held within the years, of the given type
+    MedalFilter filter;
+    medalFilterInit(&filter);
+    filter.startYear = startYear;
+    filter.endYear = endYear;
+    filter.season = gameType;
+
+    int rowCount = 0;
+    int *rows = medalFilterRows(&filter, medals, hosts, &rowCount);
+
+    TopNResult *result = rows != NULL ? computeTopN(n, athletes, medals, rows, rowCount, hosts) : NULL;
+    free(rows);
+
+    if(result == NULL) {
+        printf("Not enough memory to compute the top athletes.\n");
+        return;
+    }
+
+    // Validate empty filtered athletes
+    if(result->count == 0) printf("There aren't any athletes that won any medals.\n");
+    else printTopN(result, hosts);
+
+    destroyTopNResult(&result);
 }
 
 /**
  * @brief Retrieves the disciplines of a given game from a set of medals.
  * @param medals The list of medals.
  * @param gameSlug The identifier for the game.
- * @return A set of disciplines associated with the specified game.
+ * @return A set with one medal per discipline of the specified game.
  */
 PtAdtSet getGameSlugDisciplines(PtListMedal medals, char* gameSlug) {
+    MedalFilter filter;
+    medalFilterInit(&filter);
+    filter.game = gameSlug;
+
     int size = 0;
-    listMedalSize(medals, &size);
+    int *rows = medalFilterRows(&filter, medals, NULL, &size);
 
-    PtAdtSet disciplines = setCreate();
+    PtAdtSet disciplines = setCreateWithKey(setKeyDiscipline);
     for(int i = 0; i < size; i++) {
         Medal current;
-        listMedalGet(medals, i, &current);
+        listMedalGet(medals, rows[i], &current);
 
-        if(strcmp(current.game, gameSlug) == 0) {
-            setAdd(disciplines, current);
-        }
+        setAdd(disciplines, current);
     }
 
+    free(rows);
+
     return disciplines;
 }
 
@@ -485,29 +533,34 @@ void showDisciplineStatistics(PtAdtSet disciplines, PtListMedal medals) {
         return;
     }
 
-    clearScreen();
-    printf("There were %d different disciplines.\n\n", discSize);
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
+    outputClearScreen(&out);
+    outputPrintf(&out, "There were %d different disciplines.\n\n", discSize);
 
     Medal *discMedals = setValues(disciplines);
     for(int i = 0; i < discSize; i++) {
-        printf("----------------------------------\n");
-        printf("Discipline: %s\n", discMedals[i].discipline);
+        outputPrintf(&out, "----------------------------------\n");
+        const char *discipline = medalString(MEDAL_DISCIPLINE, discMedals[i].discipline);
+        outputPrintf(&out, "Discipline: %s\n", discipline);
 
-        char *countryMostMedals = countryMostMedalsInDiscipline(medals, discMedals[i].discipline);
-        printf("Country with most medals: %s\n", countryMostMedals);
+        char *countryMostMedals = countryMostMedalsInDiscipline(medals, discipline);
+        outputPrintf(&out, "Country with most medals: %s\n", countryMostMedals);
         free(countryMostMedals);
 
         int totalAths = 0, women = 0;
-        getDisciplineWomenProportion(medals, discMedals[i].discipline, &women, &totalAths);
-        printf("Number of women: %d of %d total participants\n", women, totalAths);
-        printf("----------------------------------\n\n");
+        getDisciplineWomenProportion(medals, discipline, &women, &totalAths);
+        outputPrintf(&out, "Number of women: %d of %d total participants\n", women, totalAths);
+        outputPrintf(&out, "----------------------------------\n\n");
     }
 
     free(discMedals);
+    outputFree(&out);
 }
 
 typedef struct {
-    char country[MAX_COUNTRY_LENGTH];
+    int country;  ///< Code of the country.
     int gold;
     int silver;
     int bronze;
@@ -520,43 +573,44 @@ typedef struct {
  * @param discipline The discipline to analyze.
  * @return String containing the name of the country with the most medals in the specified discipline.
  */
-char* countryMostMedalsInDiscipline(PtListMedal medals, char* discipline) {
+char* countryMostMedalsInDiscipline(PtListMedal medals, const char* discipline) {
+    MedalFilter filter;
+    medalFilterInit(&filter);
+    filter.discipline = discipline;
+
     int size = 0;
-    listMedalSize(medals, &size);
+    int *rows = medalFilterRows(&filter, medals, NULL, &size);
 
-    int countryCapacity = sizeof(medals);
-    CountryMedalCount *countryMedals = malloc(sizeof(CountryMedalCount) * countryCapacity + 1);
+    MedalColumns columns;
+    listMedalColumns(medals, &columns);
+
+    // Countries are kept in order of first appearance, 'countryIndex' maps a country code to its entry
+    int countryCodes = medalStringCount(MEDAL_COUNTRY);
+    CountryMedalCount *countryMedals = calloc(countryCodes > 0 ? countryCodes : 1, sizeof(CountryMedalCount));
+    int *countryIndex = malloc((countryCodes > 0 ? countryCodes : 1) * sizeof(int));
     int countryCount = 0;
 
-    // Initialize countryMedals array
-    for (int i = 0; i < countryCapacity; i++) {
-        countryMedals[i].gold = 0;
-        countryMedals[i].silver = 0;
-        countryMedals[i].bronze = 0;
-        countryMedals[i].total = 0;
-        strcpy(countryMedals[i].country, "");
+    if(countryMedals == NULL || countryIndex == NULL) {
+        free(countryMedals);
+        free(countryIndex);
+        free(rows);
+        return strdup("");
     }
 
-    for(int i = 0; i < size; i++) {       
-        Medal current;
-        listMedalGet(medals, i, &current);
+    for(int i = 0; i < countryCodes; i++) countryIndex[i] = -1;
 
-        if (strcmp(current.discipline, discipline) != 0) continue;
+    for(int i = 0; i < size; i++) {       
+        int country = columns.country[rows[i]];
 
         // Fill in the struct with country medal data
-        int j;
-        for (j = 0; j < countryCount; j++) {
-            if (strcmp(countryMedals[j].country, current.country) == 0) {
-                break;
-            }
-        }
-
-        if (j == countryCount) {
-            strcpy(countryMedals[countryCount].country, current.country);
-            countryCount++;
+        int j = countryIndex[country];
+        if (j == -1) {
+            j = countryCount++;
+            countryIndex[country] = j;
+            countryMedals[j].country = country;
         }
 
-        switch (current.medalType) {
+        switch (columns.medalType[rows[i]]) {
             case 'G':
                 countryMedals[j].gold++;
                 break;
@@ -570,6 +624,9 @@ char* countryMostMedalsInDiscipline(PtListMedal medals, char* discipline) {
         countryMedals[j].total++;
     }
 
+    free(rows);
+    free(countryIndex);
+
     // Find the country with the most medals
     int maxIndex = -1;
     int maxMedals = 0;
@@ -581,10 +638,12 @@ char* countryMostMedalsInDiscipline(PtListMedal medals, char* discipline) {
     }
 
     // No medals found so no country with most medals
-    if (maxIndex == -1) return "";
+    if (maxIndex == -1) {
+        free(countryMedals);
+        return strdup("");
+    }
 
-    char *country = malloc(sizeof(countryMedals[maxIndex].country) + 1);
-    strcpy(country, countryMedals[maxIndex].country);
+    char *country = strdup(medalString(MEDAL_COUNTRY, countryMedals[maxIndex].country));
 
     free(countryMedals);
 
@@ -598,21 +657,16 @@ char* countryMostMedalsInDiscipline(PtListMedal medals, char* discipline) {
  * @param womenCount Pointer to store the count of women.
  * @param athleteCount Pointer to store the total count of athletes.
  */
-void getDisciplineWomenProportion(PtListMedal medals, char* discipline, int *womenCount, int *athleteCount) {
-    int medalSize = 0;
-    listMedalSize(medals, &medalSize);
-
-    *womenCount = 0;
-    *athleteCount = 0;
-
-    for(int i = 0; i < medalSize; i++) {
-        Medal current;
-        listMedalGet(medals, i, &current);
-
-        if (strcmp(current.discipline, discipline) != 0) continue;
-
-        if(strcmp(current.gender, "Women") == 0) (*womenCount)++;
-
-        (*athleteCount)++;
-    }
+void getDisciplineWomenProportion(PtListMedal medals, const char* discipline, int *womenCount, int *athleteCount) {
+    MedalFilter filter;
+    medalFilterInit(&filter);
+    filter.discipline = discipline;
+
+    // Only the counts are needed, so the matches are kept as bitmaps instead of rows
+    uint64_t *matches = medalFilterBitmap(&filter, medals, NULL, athleteCount);
+    free(matches);
+
+    filter.gender = "Women";
+    matches = medalFilterBitmap(&filter, medals, NULL, womenCount);
+    free(matches);
 }
\ No newline at end of file
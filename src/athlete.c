@@ -31,6 +31,7 @@ Athlete* createAthlete(const char* id, const char* name, int participations, int
         newAthlete->gamesParticipations = participations;
         newAthlete->yearFirstParticipation = firstYear;
         newAthlete->athleteBirth = birthYear;
+        athleteSetNameKey(newAthlete);
     }
     return newAthlete;
 }
@@ -49,9 +50,115 @@ Athlete* createEmptyAthlete() {
  * @param athlete The Athlete to print.
  */
 void printAthlete(Athlete athlete) {
-    printf("Athlete ID: %s\n", athlete.athleteID);
-    printf("Name: %s\n", athlete.athleteName);
-    printf("Games Participations: %d\n", athlete.gamesParticipations);
-    printf("First Participation: %d\n", athlete.yearFirstParticipation);
-    printf("Birth Year: %d\n", athlete.athleteBirth);
+    char block[OUTPUT_RECORD_CAPACITY];
+    OutputBuffer out;
+    outputInitBlock(&out, block, OUTPUT_RECORD_CAPACITY);
+
+    formatAthlete(&out, &athlete);
+
+    outputFree(&out);
+}
+
+/**
+ * @brief Appends the details of an athlete to an output buffer.
+ * @param out The buffer.
+ * @param athlete The Athlete to print.
+ */
+void formatAthlete(OutputBuffer *out, const Athlete *athlete) {
+    outputPrintf(out, "Athlete ID: %s\n", athlete->athleteID);
+    outputPrintf(out, "Name: %s\n", athlete->athleteName);
+    outputPrintf(out, "Games Participations: %d\n", athlete->gamesParticipations);
+    outputPrintf(out, "First Participation: %d\n", athlete->yearFirstParticipation);
+    outputPrintf(out, "Birth Year: %d\n", athlete->athleteBirth);
+}
+
+/**
+ * @brief Folds an ASCII uppercase letter to lowercase, regardless of the locale.
+ * @param c The byte to fold.
+ * @return The folded byte, or 'c' if it is not an uppercase letter.
+ */
+static unsigned char foldCase(unsigned char c) {
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+/**
+ * @brief Computes the case-folded sort key of the name of an athlete.
+ * @param athlete The athlete.
+ */
+void athleteSetNameKey(Athlete *athlete) {
+    const unsigned char *name = (const unsigned char*)athlete->athleteName;
+    int length = strnlen(athlete->athleteName, MAX_ATHLETE_NAME_LENGTH);
+
+    for (int w = 0; w < NAME_KEY_WORDS; w++) {
+        uint64_t key = 0;
+
+        // Bytes past the end of the name count as zeros, like the terminator in strcmp
+        for (int i = w * 8; i < w * 8 + 8; i++)
+            key = (key << 8) | (i < length ? foldCase(name[i]) : 0);
+
+        athlete->nameKey[w] = key;
+    }
+}
+
+/**
+ * @brief Returns the name key of an athlete.
+ * @param athlete The athlete.
+ * @return The words of the key.
+ */
+const uint64_t* athleteGetNameKey(const Athlete *athlete) {
+    return athlete->nameKey;
+}
+
+/**
+ * @brief Compares two athletes by name ignoring case, through their name keys first.
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareByName(const Athlete *a, const Athlete *b) {
+    for (int w = 0; w < NAME_KEY_WORDS; w++) {
+        if (a->nameKey[w] != b->nameKey[w]) return a->nameKey[w] < b->nameKey[w] ? -1 : 1;
+    }
+
+    // Same folded prefix: compare the whole names folded, then exactly so the order is total
+    const unsigned char *p = (const unsigned char*)a->athleteName;
+    const unsigned char *q = (const unsigned char*)b->athleteName;
+    while (*p != '\0' && foldCase(*p) == foldCase(*q)) {
+        p++;
+        q++;
+    }
+
+    if (foldCase(*p) != foldCase(*q)) return foldCase(*p) - foldCase(*q);
+
+    return strcmp(a->athleteName, b->athleteName);
+}
+
+/**
+ * @brief Compares two athletes by ID.
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareById(const Athlete *a, const Athlete *b) {
+    return strcmp(a->athleteID, b->athleteID);
+}
+
+/**
+ * @brief Compares two athletes by year of birth.
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareByBirth(const Athlete *a, const Athlete *b) {
+    return (a->athleteBirth > b->athleteBirth) - (a->athleteBirth < b->athleteBirth);
+}
+
+/**
+ * @brief Compares two athletes by number of games participations.
+ * @param a First athlete.
+ * @param b Second athlete.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+int athleteCompareByParticipations(const Athlete *a, const Athlete *b) {
+    return (a->gamesParticipations > b->gamesParticipations) - (a->gamesParticipations < b->gamesParticipations);
 }
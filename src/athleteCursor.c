@@ -0,0 +1,134 @@
+/**
+ * @file athleteCursor.c
+ * @brief Implementation of the lazy cursor over an ordered list of athletes.
+ *
+ * The cursor only remembers the range of positions of the index spanned by
+ * the current page. The next page starts at the first match after that range
+ * and the previous one ends at the last match before it, so paging scans
+ * about pageSize matches plus the athletes that do not match in between.
+ */
+#include <stdlib.h>
+#include "athleteCursor.h"
+
+/**
+ * @brief Checks if the athlete at a position of the index matches the filter.
+ * @param cursor The cursor.
+ * @param position Position in the index.
+ * @return True if the athlete matches, false otherwise.
+ */
+static bool matchesAt(const AthleteCursor *cursor, int position) {
+    if(cursor->filter == NULL) return true;
+
+    return cursor->filter(listGetRef(cursor->athletes, cursor->order[position]), cursor->filterValue);
+}
+
+/**
+ * @brief Makes the current page the matches that follow a position of the index.
+ * @param cursor The cursor.
+ * @param position Position where the page may start.
+ */
+static void fillPageFrom(AthleteCursor *cursor, int position) {
+    while(position < cursor->size && !matchesAt(cursor, position)) position++;
+    cursor->first = position;
+
+    int found = 0;
+    while(position < cursor->size && found < cursor->pageSize) {
+        if(matchesAt(cursor, position)) found++;
+        position++;
+    }
+    cursor->end = position;
+}
+
+/**
+ * @brief Opens a cursor on the first page.
+ * @param cursor The cursor to open.
+ * @param athletes The list of athletes.
+ * @param order Ranks of all athletes of the list, in the order to visit them.
+ * @param filter The filter, or NULL to visit every athlete.
+ * @param filterValue Value passed to the filter.
+ * @param pageSize Maximum number of athletes per page (at least 1).
+ */
+void athleteCursorOpen(AthleteCursor *cursor, PtList athletes, const int *order,
+                       AthleteFilter filter, int filterValue, int pageSize) {
+    cursor->athletes = athletes;
+    cursor->order = order;
+    cursor->size = 0;
+    listSize(athletes, &cursor->size);
+    cursor->filter = filter;
+    cursor->filterValue = filterValue;
+    cursor->pageSize = pageSize;
+    cursor->page = 0;
+
+    if(filter == NULL) {
+        cursor->count = cursor->size;
+        cursor->first = 0;
+        cursor->end = cursor->size < pageSize ? cursor->size : pageSize;
+        return;
+    }
+
+    // The first page is found by the same pass that counts the matches
+    cursor->count = 0;
+    cursor->first = cursor->size;
+    cursor->end = cursor->size;
+
+    for(int i = 0; i < cursor->size; i++) {
+        if(!filter(listGetRef(athletes, order[i]), filterValue)) continue;
+
+        if(cursor->count == 0) cursor->first = i;
+        if(++cursor->count == pageSize) cursor->end = i + 1;
+    }
+}
+
+/**
+ * @brief Moves a cursor to the next page.
+ * @param cursor The cursor.
+ * @return True if moved, false if the cursor is on the last page.
+ */
+bool athleteCursorNext(AthleteCursor *cursor) {
+    if((cursor->page + 1) * cursor->pageSize >= cursor->count) return false;
+
+    fillPageFrom(cursor, cursor->end);
+    cursor->page++;
+
+    return true;
+}
+
+/**
+ * @brief Moves a cursor to the previous page.
+ * @param cursor The cursor.
+ * @return True if moved, false if the cursor is on the first page.
+ */
+bool athleteCursorPrevious(AthleteCursor *cursor) {
+    if(cursor->page == 0) return false;
+
+    // Every page before the current one is full, so it ends at the last match before it
+    int position = cursor->first - 1;
+    while(!matchesAt(cursor, position)) position--;
+    cursor->end = position + 1;
+
+    int found = 0;
+    while(found < cursor->pageSize) {
+        if(matchesAt(cursor, position)) found++;
+        position--;
+    }
+    cursor->first = position + 1;
+    cursor->page--;
+
+    return true;
+}
+
+/**
+ * @brief Retrieves the athletes of the current page, read in place.
+ * @param cursor The cursor.
+ * @param rows Array with room for 'pageSize' athletes, receives the athletes of the page in order.
+ * @return Number of athletes written.
+ */
+int athleteCursorRows(const AthleteCursor *cursor, const Athlete **rows) {
+    int count = 0;
+
+    for(int i = cursor->first; i < cursor->end; i++) {
+        if(matchesAt(cursor, i)) rows[count++] = listGetRef(cursor->athletes, cursor->order[i]);
+    }
+
+    return count;
+}
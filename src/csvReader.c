@@ -0,0 +1,334 @@
+/**
+ * @file csvReader.c
+ * @brief Implementation of the memory-mapped CSV reader.
+ *
+ * The whole file is mapped read-only with mmap (or read into a single heap
+ * buffer on platforms without it) and records are tokenized in place. Fields
+ * are returned as views into that buffer instead of being copied, so a full
+ * import costs one pass over the file with no allocations per line.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "csvReader.h"
+
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    #define CSV_USE_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Reads a whole file into a heap buffer, used when mmap is not available.
+ * @param reader Reader to initialize.
+ * @param path Path of the file to read.
+ * @return True if the file was read, false otherwise.
+ */
+static bool readWholeFile(CsvReader *reader, const char *path) {
+    FILE *fs = fopen(path, "rb");
+    if(fs == NULL) return false;
+
+    fseek(fs, 0, SEEK_END);
+    long size = ftell(fs);
+    fseek(fs, 0, SEEK_SET);
+
+    if(size < 0) {
+        fclose(fs);
+        return false;
+    }
+
+    char *buffer = malloc(size > 0 ? size : 1);
+    if(buffer == NULL || fread(buffer, 1, size, fs) != (size_t)size) {
+        free(buffer);
+        fclose(fs);
+        return false;
+    }
+
+    fclose(fs);
+
+    reader->buffer = buffer;
+    reader->size = size;
+    reader->mapped = false;
+
+    return true;
+}
+
+/**
+ * @brief Opens a CSV file and maps its whole contents into memory.
+ * @param reader Reader to initialize.
+ * @param path Path of the file to open.
+ * @return True if the file was opened, false otherwise.
+ */
+bool csvOpen(CsvReader *reader, const char *path) {
+    if(reader == NULL || path == NULL) return false;
+
+    reader->buffer = NULL;
+    reader->size = 0;
+    reader->position = 0;
+    reader->mapped = false;
+    reader->owner = true;
+
+#ifdef CSV_USE_MMAP
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+
+    // mmap refuses empty files, there is nothing to read anyway
+    if(st.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping keeps its own reference to the file
+
+    if(data == MAP_FAILED) return readWholeFile(reader, path);
+
+    // Records are read once, front to back
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    reader->buffer = data;
+    reader->size = st.st_size;
+    reader->mapped = true;
+
+    return true;
+#else
+    return readWholeFile(reader, path);
+#endif
+}
+
+/**
+ * @brief Releases the file contents held by a reader.
+ * @param reader Reader to close.
+ */
+void csvClose(CsvReader *reader) {
+    if(reader == NULL || reader->buffer == NULL) return;
+
+    if(!reader->owner) { // Chunks share the buffer of the reader they came from
+        reader->buffer = NULL;
+        return;
+    }
+
+#ifdef CSV_USE_MMAP
+    if(reader->mapped) munmap((void*)reader->buffer, reader->size);
+    else free((void*)reader->buffer);
+#else
+    free((void*)reader->buffer);
+#endif
+
+    reader->buffer = NULL;
+    reader->size = 0;
+    reader->position = 0;
+}
+
+/**
+ * @brief Reads the next record of a CSV file.
+ * @param reader Reader to read from.
+ * @param fields Array that receives the field views.
+ * @param maxFields Capacity of 'fields'.
+ * @return Number of fields read, or -1 when there are no more records.
+ */
+int csvNextRecord(CsvReader *reader, CsvField *fields, int maxFields) {
+    const char *p = reader->buffer + reader->position;
+    const char *end = reader->buffer + reader->size;
+
+    // Skip empty lines
+    while(p < end && (*p == '\n' || *p == '\r')) p++;
+    if(p >= end) {
+        reader->position = reader->size;
+        return -1;
+    }
+
+    int count = 0;
+    while(true) {
+        CsvField field = { p, 0, false };
+
+        if(p < end && *p == '"') { // Quoted field, delimiters inside quotes are data
+            field.data = ++p;
+            field.quoted = true;
+
+            // Records end with their line, as csvSplit cuts chunks at any line ending
+            while(p < end && *p != '\n') {
+                if(*p == '"') {
+                    if(p + 1 < end && p[1] == '"') p += 2; // Escaped quote
+                    else break;
+                }
+                else p++;
+            }
+
+            field.length = p - field.data;
+            if(p < end && *p == '"') p++; // Closing quote
+            else if(field.length > 0 && field.data[field.length - 1] == '\r') field.length--; // Unclosed, CRLF ending
+
+            // Anything between the closing quote and the delimiter is dropped
+            while(p < end && *p != CSV_DELIMITER && *p != '\n') p++;
+        }
+        else {
+            while(p < end && *p != CSV_DELIMITER && *p != '\n') p++;
+            field.length = p - field.data;
+
+            // Trim CRLF line endings
+            if(field.length > 0 && field.data[field.length - 1] == '\r') field.length--;
+        }
+
+        if(count < maxFields) fields[count] = field;
+        count++;
+
+        if(p < end && *p == CSV_DELIMITER) {
+            p++;
+            continue;
+        }
+
+        break;
+    }
+
+    if(p < end) p++; // Line ending
+    reader->position = p - reader->buffer;
+
+    return count < maxFields ? count : maxFields;
+}
+
+/**
+ * @brief Splits the unread part of a file into newline-aligned chunks.
+ * @param reader Reader to split; its position is not changed.
+ * @param chunkCount Maximum number of chunks to produce.
+ * @param chunks Array of at least 'chunkCount' readers that receives the chunks.
+ * @return Number of chunks produced, which may be less than 'chunkCount'.
+ */
+int csvSplit(const CsvReader *reader, int chunkCount, CsvReader *chunks) {
+    size_t remaining = reader->size - reader->position;
+    size_t start = reader->position;
+
+    int count = 0;
+    for(int k = 0; k < chunkCount && start < reader->size; k++) {
+        size_t end = reader->size;
+
+        if(k < chunkCount - 1) {
+            end = reader->position + remaining / chunkCount * (k + 1);
+            if(end <= start) end = start + 1;
+
+            // Move the boundary just past the next line ending
+            while(end < reader->size && reader->buffer[end - 1] != '\n') end++;
+        }
+
+        chunks[count].buffer = reader->buffer + start;
+        chunks[count].size = end - start;
+        chunks[count].position = 0;
+        chunks[count].mapped = reader->mapped;
+        chunks[count].owner = false;
+        count++;
+
+        start = end;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Checks if a field matches a string exactly.
+ * @param field Field to compare.
+ * @param str Null terminated string to compare with.
+ * @return True if both have the same contents, false otherwise.
+ */
+bool csvFieldEquals(CsvField field, const char *str) {
+    return strncmp(field.data, str, field.length) == 0 && str[field.length] == '\0';
+}
+
+/**
+ * @brief Copies a field into a null terminated buffer.
+ * @param field Field to copy.
+ * @param dest Destination buffer.
+ * @param destSize Size of the destination buffer.
+ */
+void csvFieldCopy(CsvField field, char *dest, int destSize) {
+    if(destSize <= 0) return;
+
+    int length = field.length < destSize - 1 ? field.length : destSize - 1;
+
+    if(!field.quoted) {
+        memcpy(dest, field.data, length);
+        dest[length] = '\0';
+        return;
+    }
+
+    // Collapse escaped quotes ("") into a single one
+    int j = 0;
+    for(int i = 0; i < field.length && j < destSize - 1; i++) {
+        dest[j++] = field.data[i];
+        if(field.data[i] == '"' && i + 1 < field.length && field.data[i + 1] == '"') i++;
+    }
+
+    dest[j] = '\0';
+}
+
+/**
+ * @brief Parses a field as a decimal integer.
+ * @param field Field to parse.
+ * @return The parsed value, or 0 if the field is empty or not numeric.
+ */
+int csvFieldToInt(CsvField field) {
+    int i = 0, sign = 1, value = 0;
+
+    if(field.length > 0 && (field.data[0] == '-' || field.data[0] == '+')) {
+        if(field.data[0] == '-') sign = -1;
+        i++;
+    }
+
+    for(; i < field.length; i++) {
+        if(field.data[i] < '0' || field.data[i] > '9') break;
+        value = value * 10 + (field.data[i] - '0');
+    }
+
+    return sign * value;
+}
+
+/**
+ * @brief Resolves a header row into a per-column handler table.
+ * @param headers Fields of the header row.
+ * @param headerCount Number of fields in the header row.
+ * @param columns Known columns of the file.
+ * @param columnCount Number of known columns.
+ * @param handlers Array of at least 'headerCount' entries that receives the handlers.
+ * @return True if every header is known, false if an invalid column was found.
+ */
+bool csvResolveColumns(const CsvField *headers, int headerCount, const CsvColumn *columns, int columnCount, CsvFieldHandler *handlers) {
+    for(int i = 0; i < headerCount; i++) {
+        handlers[i] = NULL;
+
+        if(headers[i].length == 0) continue;
+
+        int j = 0;
+        for(; j < columnCount; j++) {
+            if(csvFieldEquals(headers[i], columns[j].header)) {
+                handlers[i] = columns[j].handler;
+                break;
+            }
+        }
+
+        if(j == columnCount) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Dispatches the fields of a row to their resolved handlers.
+ * @param record Record being filled.
+ * @param fields Fields of the row.
+ * @param fieldCount Number of fields in the row.
+ * @param handlers Handler table produced by csvResolveColumns.
+ * @param handlerCount Number of entries in 'handlers'.
+ */
+void csvApplyRecord(void *record, const CsvField *fields, int fieldCount, const CsvFieldHandler *handlers, int handlerCount) {
+    int count = fieldCount < handlerCount ? fieldCount : handlerCount;
+
+    for(int i = 0; i < count; i++)
+        if(handlers[i] != NULL) handlers[i](record, fields[i]);
+}
@@ -0,0 +1,329 @@
+/**
+ * @file filterKernels.c
+ * @brief Implementation of the vectorized predicate kernels over columns.
+ *
+ * Every kernel has a plain C version and, on x86, SSE2 and AVX2 versions.
+ * The vector versions fill whole 64-row words with compares and movemasks
+ * and leave the last, partial word to the plain C version. The AVX2 versions
+ * are compiled with a target attribute, so the program still runs on
+ * processors without AVX2; the implementation is chosen once, at runtime.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "filterKernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && defined(__SSE2__)
+    #define KERNELS_USE_X86
+    #include <immintrin.h>
+#endif
+
+/**
+ * One implementation of every kernel.
+ */
+typedef struct kernelSet {
+    const char *name;
+    void (*equalsInt)(const int *column, int count, int value, uint64_t *bitmap);
+    void (*equalsChar)(const char *column, int count, char value, uint64_t *bitmap);
+    void (*inSet)(const int *column, int count, const int *set, int setSize, uint64_t *bitmap);
+} KernelSet;
+
+/* -------------------------------- Scalar -------------------------------- */
+
+static void equalsIntScalar(const int *column, int count, int value, uint64_t *bitmap) {
+    for (int base = 0, w = 0; base < count; base += 64, w++) {
+        int end = count - base < 64 ? count - base : 64;
+        uint64_t bits = 0;
+
+        for (int i = 0; i < end; i++) bits |= (uint64_t)(column[base + i] == value) << i;
+        bitmap[w] = bits;
+    }
+}
+
+static void equalsCharScalar(const char *column, int count, char value, uint64_t *bitmap) {
+    for (int base = 0, w = 0; base < count; base += 64, w++) {
+        int end = count - base < 64 ? count - base : 64;
+        uint64_t bits = 0;
+
+        for (int i = 0; i < end; i++) bits |= (uint64_t)(column[base + i] == value) << i;
+        bitmap[w] = bits;
+    }
+}
+
+static void inSetScalar(const int *column, int count, const int *set, int setSize, uint64_t *bitmap) {
+    for (int base = 0, w = 0; base < count; base += 64, w++) {
+        int end = count - base < 64 ? count - base : 64;
+        uint64_t bits = 0;
+
+        for (int i = 0; i < end; i++) {
+            int code = column[base + i];
+            bits |= (uint64_t)(code >= 0 && code < setSize && set[code] != 0) << i;
+        }
+        bitmap[w] = bits;
+    }
+}
+
+static const KernelSet scalarKernels = {
+    "scalar", equalsIntScalar, equalsCharScalar, inSetScalar
+};
+
+#ifdef KERNELS_USE_X86
+
+/* --------------------------------- SSE2 --------------------------------- */
+
+static void equalsIntSse2(const int *column, int count, int value, uint64_t *bitmap) {
+    int words = count / 64;
+    __m128i target = _mm_set1_epi32(value);
+
+    for (int w = 0; w < words; w++) {
+        const int *rows = column + w * 64;
+        uint64_t bits = 0;
+
+        for (int i = 0; i < 64; i += 4) {
+            __m128i values = _mm_loadu_si128((const __m128i*)(rows + i));
+            uint64_t mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(values, target)));
+            bits |= mask << i;
+        }
+        bitmap[w] = bits;
+    }
+
+    equalsIntScalar(column + words * 64, count - words * 64, value, bitmap + words);
+}
+
+static void equalsCharSse2(const char *column, int count, char value, uint64_t *bitmap) {
+    int words = count / 64;
+    __m128i target = _mm_set1_epi8(value);
+
+    for (int w = 0; w < words; w++) {
+        const char *rows = column + w * 64;
+        uint64_t bits = 0;
+
+        for (int i = 0; i < 64; i += 16) {
+            __m128i values = _mm_loadu_si128((const __m128i*)(rows + i));
+            uint64_t mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(values, target));
+            bits |= mask << i;
+        }
+        bitmap[w] = bits;
+    }
+
+    equalsCharScalar(column + words * 64, count - words * 64, value, bitmap + words);
+}
+
+// SSE2 has no gather, set membership stays scalar
+static const KernelSet sse2Kernels = {
+    "sse2", equalsIntSse2, equalsCharSse2, inSetScalar
+};
+
+/* --------------------------------- AVX2 --------------------------------- */
+
+__attribute__((target("avx2")))
+static void equalsIntAvx2(const int *column, int count, int value, uint64_t *bitmap) {
+    int words = count / 64;
+    __m256i target = _mm256_set1_epi32(value);
+
+    for (int w = 0; w < words; w++) {
+        const int *rows = column + w * 64;
+        uint64_t bits = 0;
+
+        for (int i = 0; i < 64; i += 8) {
+            __m256i values = _mm256_loadu_si256((const __m256i*)(rows + i));
+            uint64_t mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(values, target)));
+            bits |= mask << i;
+        }
+        bitmap[w] = bits;
+    }
+
+    equalsIntScalar(column + words * 64, count - words * 64, value, bitmap + words);
+}
+
+__attribute__((target("avx2")))
+static void equalsCharAvx2(const char *column, int count, char value, uint64_t *bitmap) {
+    int words = count / 64;
+    __m256i target = _mm256_set1_epi8(value);
+
+    for (int w = 0; w < words; w++) {
+        const char *rows = column + w * 64;
+
+        __m256i low = _mm256_loadu_si256((const __m256i*)rows);
+        __m256i high = _mm256_loadu_si256((const __m256i*)(rows + 32));
+        uint64_t lowMask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, target));
+        uint64_t highMask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, target));
+
+        bitmap[w] = lowMask | highMask << 32;
+    }
+
+    equalsCharScalar(column + words * 64, count - words * 64, value, bitmap + words);
+}
+
+__attribute__((target("avx2")))
+static void inSetAvx2(const int *column, int count, const int *set, int setSize, uint64_t *bitmap) {
+    int words = count / 64;
+    __m256i zero = _mm256_setzero_si256();
+    __m256i minusOne = _mm256_set1_epi32(-1), size = _mm256_set1_epi32(setSize);
+
+    for (int w = 0; w < words; w++) {
+        const int *rows = column + w * 64;
+        uint64_t bits = 0;
+
+        for (int i = 0; i < 64; i += 8) {
+            __m256i codes = _mm256_loadu_si256((const __m256i*)(rows + i));
+
+            // Only codes inside the set table are gathered, the other lanes read as zero
+            __m256i valid = _mm256_and_si256(_mm256_cmpgt_epi32(codes, minusOne), _mm256_cmpgt_epi32(size, codes));
+            __m256i members = _mm256_mask_i32gather_epi32(zero, set, codes, valid, 4);
+
+            uint64_t mask = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(members, zero))) & 0xFF;
+            bits |= mask << i;
+        }
+        bitmap[w] = bits;
+    }
+
+    inSetScalar(column + words * 64, count - words * 64, set, setSize, bitmap + words);
+}
+
+static const KernelSet avx2Kernels = {
+    "avx2", equalsIntAvx2, equalsCharAvx2, inSetAvx2
+};
+
+#endif
+
+/* ------------------------------- Dispatch ------------------------------- */
+
+static const KernelSet *kernels = &scalarKernels;
+static pthread_once_t kernelsSelected = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Finds an implementation supported by the processor.
+ * @param name Name of the instruction set.
+ * @return The implementation, or NULL if unknown or not supported.
+ */
+static const KernelSet* findKernels(const char *name) {
+    if (strcmp(name, "scalar") == 0) return &scalarKernels;
+
+#ifdef KERNELS_USE_X86
+    __builtin_cpu_init();
+    if (strcmp(name, "sse2") == 0) return &sse2Kernels;
+    if (strcmp(name, "avx2") == 0 && __builtin_cpu_supports("avx2")) return &avx2Kernels;
+#endif
+
+    return NULL;
+}
+
+/**
+ * @brief Selects the best implementation supported by the processor.
+ */
+static void selectKernels() {
+    const KernelSet *best = findKernels("avx2");
+    if (best == NULL) best = findKernels("sse2");
+
+    if (best != NULL) kernels = best;
+}
+
+/**
+ * @brief Returns the selected implementation, selecting it on first use.
+ * @return The implementation.
+ */
+static const KernelSet* activeKernels() {
+    pthread_once(&kernelsSelected, selectKernels);
+
+    return kernels;
+}
+
+/**
+ * @brief Selects the rows where an int column equals a value.
+ * @param column The column.
+ * @param count Number of rows.
+ * @param value The value to compare with.
+ * @param bitmap Bitmap that receives the selection.
+ */
+void kernelEqualsInt(const int *column, int count, int value, uint64_t *bitmap) {
+    activeKernels()->equalsInt(column, count, value, bitmap);
+}
+
+/**
+ * @brief Selects the rows where a char column equals a value.
+ * @param column The column.
+ * @param count Number of rows.
+ * @param value The value to compare with.
+ * @param bitmap Bitmap that receives the selection.
+ */
+void kernelEqualsChar(const char *column, int count, char value, uint64_t *bitmap) {
+    activeKernels()->equalsChar(column, count, value, bitmap);
+}
+
+/**
+ * @brief Selects the rows whose code belongs to a set.
+ * @param column Column of codes.
+ * @param count Number of rows.
+ * @param set Membership of each code.
+ * @param setSize Number of entries of 'set'.
+ * @param bitmap Bitmap that receives the selection.
+ */
+void kernelInSet(const int *column, int count, const int *set, int setSize, uint64_t *bitmap) {
+    activeKernels()->inSet(column, count, set, setSize, bitmap);
+}
+
+/**
+ * @brief Intersects a bitmap with another one.
+ * @param dest Bitmap that receives the result.
+ * @param src Second operand.
+ * @param words Number of words.
+ */
+void bitmapAnd(uint64_t *dest, const uint64_t *src, int words) {
+    for (int w = 0; w < words; w++) dest[w] &= src[w];
+}
+
+/**
+ * @brief Counts the selected rows of a bitmap.
+ * @param bitmap The bitmap.
+ * @param words Number of words.
+ * @return Number of set bits.
+ */
+int bitmapCount(const uint64_t *bitmap, int words) {
+    int count = 0;
+    for (int w = 0; w < words; w++) count += __builtin_popcountll(bitmap[w]);
+
+    return count;
+}
+
+/**
+ * @brief Lists the selected rows of a bitmap, in ascending order.
+ * @param bitmap The bitmap.
+ * @param words Number of words.
+ * @param rows Array that receives the rows.
+ * @return Number of rows written.
+ */
+int bitmapToRows(const uint64_t *bitmap, int words, int *rows) {
+    int count = 0;
+
+    for (int w = 0; w < words; w++) {
+        // Clear the lowest set bit until the word is empty
+        for (uint64_t bits = bitmap[w]; bits != 0; bits &= bits - 1)
+            rows[count++] = w * 64 + __builtin_ctzll(bits);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns the name of the instruction set used by the kernels.
+ * @return "avx2", "sse2" or "scalar".
+ */
+const char* kernelInstructionSet() {
+    return activeKernels()->name;
+}
+
+/**
+ * @brief Forces the kernels to use an instruction set.
+ * @param name "avx2", "sse2" or "scalar".
+ * @return True if selected, false if unknown or not supported by the processor.
+ */
+bool kernelUseInstructionSet(const char *name) {
+    pthread_once(&kernelsSelected, selectKernels);
+
+    const KernelSet *selected = findKernels(name);
+    if (selected == NULL) return false;
+
+    kernels = selected;
+    return true;
+}
@@ -3,9 +3,8 @@
  * @brief Implementation file for helper functions used throughout the Olympics Super Parser program.
  *
  * This file includes implementations of utility functions that assist with string manipulation,
- * sorting algorithms, data parsing, and other general-purpose functionalities to support
- * the main operations of the program. Functions include date handling, string processing,
- * quick sort algorithm for lists, and more.
+ * data parsing, and other general-purpose functionalities to support the main operations
+ * of the program. Functions include date handling, string processing, and more.
  */
 #include <stdio.h>
 #include <stdlib.h>
@@ -14,8 +13,10 @@
 #include "helpers.h"
 #include "input.h"
 #include "list.h"
+#include "outputBuffer.h"
 
 #define MAX_NUMS_STR 200
+#define RADIX_SORT_THRESHOLD 32  ///< Ranges of keys below this size are sorted by insertion instead of by radix.
 
 /**
  * @brief Displays the start menu and captures user choice.
@@ -27,7 +28,7 @@ int startMenu() {
     printf("\n---------- Olympics Super Parser ----------\n");
     printf("1. LOAD_A - Loads all athletes in athletes.csv.\n");
     printf("2. LOAD_M - Loads all medals in medals.csv.\n");
-    printf("3. LOAD_M - Loads all hosts in hosts.csv.\n");
+    printf("3. LOAD_H - Loads all hosts in hosts.csv.\n");
     printf("4. CLEAR - Clears all data in memory.\n");
     printf("5. SHOW_ALL - Shows all athletes.\n");
     printf("6. SHOW_PARTICIPATIONS - Shows all athletes that participated x amount.\n");
@@ -36,6 +37,7 @@ int startMenu() {
     printf("9. DISCIPLINE_STATISTICS - Shows statistics about a given discipline\n");
     printf("10. ATHLETE_INFO - Shows info about an athlete\n");
     printf("11. TOPN - N athletes with most medals\n");
+    printf("12. LOAD_ALL - Loads athletes, medals and hosts at the same time.\n");
     printf("0. QUIT - Leaves the program (all data is cleared).\n");
     printf("-------------------------------------------\n\n");
 
@@ -69,8 +71,8 @@ int getNumbersFromString(char *str) {
  * @param str The string to process.
  * @return A new string containing only non-numeric characters.
  */
-char* getCharsOnlyFromString(char *str) {
-    char *p = str;
+char* getCharsOnlyFromString(const char *str) {
+    const char *p = str;
 
     char *finalString = malloc(strlen(str) + 1);
     if (finalString == NULL) return NULL;
@@ -156,7 +158,7 @@ int concatenate(int x, int y) {
  */
 void clearScreen(){
     #if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
-        system("clear");
+        fputs(ANSI_CLEAR_SCREEN, stdout);
     #endif
 
     #if defined(_WIN32) || defined(_WIN64)
@@ -164,64 +166,6 @@ void clearScreen(){
     #endif
 }
 
-/**
- * @brief Implements the quick sort algorithm on a list of athletes.
- * @param athletes Pointer to the list of athletes.
- * @param low Starting index.
- * @param high Ending index.
- */
-void quickSort(PtList *athletes, int low, int high) {
-    if (low >= high) return;
-
-    int pivot = partition(athletes, low, high);
-
-    quickSort(athletes, low, pivot - 1); // Sort first half
-    quickSort(athletes, pivot + 1, high); // Sort second half
-}
-
-/**
- * @brief Partitions the list around a pivot for quick sort.
- * @param athletes Pointer to the list of athletes.
- * @param low Starting index.
- * @param high Ending index.
- * @return New pivot index.
- */
-int partition(PtList *athletes, int low, int high) {
-    // Get pivot
-    Athlete pivotAth;
-    listGet(*athletes, high, &pivotAth);
-
-    int i = (low - 1);
-    for (int j = low; j <= high - 1; j++) {
-        Athlete currentAth;
-        listGet(*athletes, j, &currentAth);
-
-        if (strcmp(currentAth.athleteName, pivotAth.athleteName) < 0) {
-            i++;
-            swapAthletes(athletes, i, j);
-        }
-    }
-
-    swapAthletes(athletes, i + 1, high);
-    return (i + 1);
-}
-
-/**
- * @brief Swaps two athletes in a list.
- * @param athletes Pointer to the list of athletes.
- * @param i Index of the first athlete.
- * @param j Index of the second athlete.
- */
-void swapAthletes(PtList *athletes, int i, int j) {
-    Athlete ath1, ath2;
-    listGet(*athletes, i, &ath1);
-    listGet(*athletes, j, &ath2);
-
-    listSet(*athletes, i, ath2, NULL);
-    listSet(*athletes, j, ath1, NULL);
-}
-
-
 /**
  * @brief Extracts the year from a date string.
  * @param date Date string in the format "YYYY-MM-DD".
@@ -240,7 +184,7 @@ int getYearFromDate(char* date) {
  * @param str String to convert.
  * @return A new string in lowercase.
  */
-char* stringToLower(char* str) {
+char* stringToLower(const char* str) {
     if (str == NULL) return NULL;
     
     char* lowercase = malloc(strlen(str) + 1);
@@ -253,4 +197,173 @@ char* stringToLower(char* str) {
     lowercase[strlen(str)] = '\0';
     
     return lowercase;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Compares two strings ignoring case.
+ * @param str1 First string.
+ * @param str2 Second string.
+ * @return 0 if equal ignoring case, otherwise the difference of the first lowercase characters that differ.
+ */
+int compareIgnoreCase(const char *str1, const char *str2) {
+    const unsigned char *p1 = (const unsigned char*)str1;
+    const unsigned char *p2 = (const unsigned char*)str2;
+
+    while (*p1 != '\0' && tolower(*p1) == tolower(*p2)) {
+        p1++;
+        p2++;
+    }
+
+    return tolower(*p1) - tolower(*p2);
+}
+
+/**
+ * @brief Hashes a string with the 32-bit FNV-1a hash.
+ * @param str The string to hash.
+ * @return The hash of the string.
+ */
+unsigned int hashString(const char *str) {
+    unsigned int hash = 2166136261u;
+
+    for (const unsigned char *p = (const unsigned char*)str; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/**
+ * @brief Returns a byte of a key, counting from the most significant byte of its first word.
+ * @param key Words of the key.
+ * @param depth Position of the byte.
+ * @return The byte.
+ */
+static unsigned char keyByte(const uint64_t *key, int depth) {
+    return (unsigned char)(key[depth / 8] >> (56 - 8 * (depth % 8)));
+}
+
+/**
+ * @brief Compares two keys word by word, from the word holding a given byte on.
+ * @param a First key.
+ * @param b Second key.
+ * @param words Number of words of the keys.
+ * @param depth Number of leading bytes that both keys share.
+ * @return Negative, zero or positive if 'a' comes before, with or after 'b'.
+ */
+static int compareKeyWords(const uint64_t *a, const uint64_t *b, int words, int depth) {
+    for (int w = depth / 8; w < words; w++) {
+        if (a[w] != b[w]) return a[w] < b[w] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Sorts keys (and their items) by insertion, comparing them from a given byte on.
+ * @param keys Keys to sort.
+ * @param words Number of words of each key.
+ * @param items Item of each key, moved along with it.
+ * @param count Number of keys.
+ * @param depth Number of leading bytes that all keys share.
+ */
+static void insertionSortKeyWords(const uint64_t **keys, int words, int *items, int count, int depth) {
+    for (int i = 1; i < count; i++) {
+        const uint64_t *key = keys[i];
+        int item = items[i];
+
+        // Strictly greater keeps equal keys in their original order
+        int j = i;
+        for (; j > 0 && compareKeyWords(keys[j - 1], key, words, depth) > 0; j--) {
+            keys[j] = keys[j - 1];
+            items[j] = items[j - 1];
+        }
+
+        keys[j] = key;
+        items[j] = item;
+    }
+}
+
+/**
+ * @brief Sorts keys (and their items) by their byte at 'depth', then each bucket by the next byte.
+ * @param keys Keys to sort.
+ * @param words Number of words of each key.
+ * @param items Item of each key, moved along with it.
+ * @param count Number of keys.
+ * @param depth Number of leading bytes that all keys share.
+ * @param tmpKeys Scratch array of at least 'count' keys.
+ * @param tmpItems Scratch array of at least 'count' items.
+ * @param bytes Scratch array of at least 'count' bytes.
+ */
+static void radixSortKeyWords(const uint64_t **keys, int words, int *items, int count, int depth,
+                              const uint64_t **tmpKeys, int *tmpItems, unsigned char *bytes) {
+    if (count < RADIX_SORT_THRESHOLD) {
+        insertionSortKeyWords(keys, words, items, count, depth);
+        return;
+    }
+
+    // Each byte is read from its key once and cached, the keys are usually far apart in memory
+    int bucketStart[257] = {0};
+    for (int i = 0; i < count; i++) {
+        bytes[i] = keyByte(keys[i], depth);
+        bucketStart[bytes[i] + 1]++;
+    }
+
+    for (int b = 0; b < 256; b++) bucketStart[b + 1] += bucketStart[b];
+
+    int next[256];
+    memcpy(next, bucketStart, sizeof(next));
+
+    // Distributing in input order keeps the sort stable
+    for (int i = 0; i < count; i++) {
+        int pos = next[bytes[i]]++;
+        tmpKeys[pos] = keys[i];
+        tmpItems[pos] = items[i];
+    }
+
+    memcpy(keys, tmpKeys, count * sizeof(const uint64_t*));
+    memcpy(items, tmpItems, count * sizeof(int));
+
+    // Past the last byte the keys of a bucket are all equal
+    if (depth + 1 == words * 8) return;
+
+    for (int b = 0; b < 256; b++) {
+        int size = bucketStart[b + 1] - bucketStart[b];
+        if (size > 1)
+            radixSortKeyWords(keys + bucketStart[b], words, items + bucketStart[b], size, depth + 1, tmpKeys, tmpItems, bytes);
+    }
+}
+
+/**
+ * @brief Sorts keys of unsigned words, moving an item along with each key.
+ * @param keys Keys to sort.
+ * @param words Number of words of each key.
+ * @param items Item of each key (e.g., a slot of a list).
+ * @param count Number of keys.
+ * @return 1 if successful, 0 on memory allocation failure (keys and items are left as they were).
+ */
+int sortKeyWords(const uint64_t **keys, int words, int *items, int count) {
+    if (count < RADIX_SORT_THRESHOLD) {
+        insertionSortKeyWords(keys, words, items, count, 0);
+        return 1;
+    }
+
+    const uint64_t **tmpKeys = malloc(count * sizeof(const uint64_t*));
+    int *tmpItems = malloc(count * sizeof(int));
+    unsigned char *bytes = malloc(count);
+
+    if (tmpKeys == NULL || tmpItems == NULL || bytes == NULL) {
+        free(tmpKeys);
+        free(tmpItems);
+        free(bytes);
+        return 0;
+    }
+
+    radixSortKeyWords(keys, words, items, count, 0, tmpKeys, tmpItems, bytes);
+
+    free(tmpKeys);
+    free(tmpItems);
+    free(bytes);
+
+    return 1;
+}
@@ -9,10 +9,60 @@
  */
 #include "host.h"
 #include "helpers.h"
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/**
+ * @brief Parses the date part of an ISO 8601 timestamp (YYYY-MM-DDThh:mm:ssZ).
+ * @param date The timestamp to parse.
+ * @param year Pointer to store the year.
+ * @param month Pointer to store the month.
+ * @param day Pointer to store the day.
+ * @return True if the date part is valid, false otherwise.
+ */
+static bool parseIsoDate(const char *date, int *year, int *month, int *day) {
+    int parts[3] = { 0, 0, 0 };
+    const char *p = date;
+
+    for (int i = 0; i < 3; i++) {
+        if (*p < '0' || *p > '9') return false;
+
+        while (*p >= '0' && *p <= '9') parts[i] = parts[i] * 10 + (*p++ - '0');
+
+        // Year and month are followed by a dash
+        if (i < 2 && *p++ != '-') return false;
+    }
+
+    if (parts[1] < 1 || parts[1] > 12 || parts[2] < 1 || parts[2] > 31) return false;
+
+    *year = parts[0];
+    *month = parts[1];
+    *day = parts[2];
+
+    return true;
+}
+
+/**
+ * @brief Parses the start and end dates of a Host into its numeric date fields.
+ * @param host The Host whose startDate and endDate are parsed.
+ */
+void computeHostDates(Host *host) {
+    int startMonth, startDay, endMonth, endDay;
+
+    bool validStart = parseIsoDate(host->startDate, &host->startYear, &startMonth, &startDay);
+    bool validEnd = parseIsoDate(host->endDate, &host->endYear, &endMonth, &endDay);
+
+    if (!validStart) host->startYear = host->startJulian = 0;
+    else host->startJulian = dateToJulianDay(host->startYear, startMonth, startDay);
+
+    if (!validEnd) host->endYear = host->endJulian = 0;
+    else host->endJulian = dateToJulianDay(host->endYear, endMonth, endDay);
+
+    host->duration = validStart && validEnd ? abs(host->endJulian - host->startJulian) : -1;
+}
+
 /**
  * @brief Creates a new Host instance with specified details.
  * @param slug Unique slug identifier for the game.
@@ -35,6 +85,8 @@ Host* createHost(const char* slug, const char* endDate, const char* startDate, c
         strncpy(newHost->gameName, gameName, MAX_GAME_NAME_LENGTH);
         strncpy(newHost->season, season, MAX_HOST_NAME_LENGTH);
         newHost->year = year;
+
+        computeHostDates(newHost);
     }
     return newHost;
 }
@@ -53,13 +105,27 @@ Host* createEmptyHost() {
  * @param host The Host to print.
  */
 void printHost(Host host) {
-    char *hostingCity = getCharsOnlyFromString(host.gameName);
-    int duration = getDateDiffInDays(host.startDate, host.endDate);
+    char block[OUTPUT_RECORD_CAPACITY];
+    OutputBuffer out;
+    outputInitBlock(&out, block, OUTPUT_RECORD_CAPACITY);
+
+    formatHost(&out, &host);
+
+    outputFree(&out);
+}
+
+/**
+ * @brief Appends the details of a Host to an output buffer.
+ * @param out The buffer.
+ * @param host The Host to print.
+ */
+void formatHost(OutputBuffer *out, const Host *host) {
+    char *hostingCity = getCharsOnlyFromString(host->gameName);
 
-    printf("Hosting City: %s\n", hostingCity);
-    printf("Year: %d\n", host.year);
-    printf("Location: %s\n", host.location);
-    printf("Duration (days): %d\n", duration);
+    outputPrintf(out, "Hosting City: %s\n", hostingCity);
+    outputPrintf(out, "Year: %d\n", host->year);
+    outputPrintf(out, "Location: %s\n", host->location);
+    outputPrintf(out, "Duration (days): %d\n", host->duration);
 
     free(hostingCity);
 }
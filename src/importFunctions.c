@@ -5,10 +5,18 @@
  * This file contains implementations for functions that read and parse CSV files to create
  * lists and maps of athletes, medals, and hosts respectively. It handles the opening and
  * reading of files, parsing of CSV format, and populating data structures with parsed data.
+ * Files are memory-mapped through the csvReader module and every field is read as a view
+ * into the mapping, so no heap allocations are made per line. Large athlete and medal
+ * files are split into newline-aligned chunks that are parsed on a pool of threads.
+ * The text fields of medals are interned while parsing: each worker fills dictionaries
+ * of its own, which are merged into the shared medal dictionaries with the chunks.
+ * Each successful import is saved as a binary snapshot, which is loaded instead of the
+ * CSV file on later imports while the CSV file stays unchanged.
  */
 #include <stdio.h> 
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include "importFunctions.h"
 #include "helpers.h"
@@ -18,85 +26,453 @@
 #include "athlete.h"
 #include "medal.h"
 #include "host.h"
+#include "csvReader.h"
+#include "snapshot.h"
+#include "stringPool.h"
+
+#define ATHLETES_FILE "data/athletes.csv"
+#define MEDALS_FILE "data/medals.csv"
+#define HOSTS_FILE "data/hosts.csv"
 
-#define MAX_LINE_LENGTH 1024
-#define MAX_FIELDS 100
 #define MAX_FIELD_HEADERS 10
+#define MAX_FIRST_GAME_LENGTH 100
+#define MAX_IMPORT_THREADS 64
+#define MIN_CHUNK_BYTES (256 * 1024) ///< Files smaller than this are not worth splitting.
+#define ESTIMATED_BYTES_PER_ROW 64
+
+static int importThreadCount = DEFAULT_IMPORT_THREADS;
+
+/**
+ * Rows parsed from one chunk of a file by one worker.
+ */
+typedef struct importChunk {
+    CsvReader reader;                 ///< Slice of the file to parse.
+    const CsvFieldHandler *handlers;  ///< Resolved column handlers.
+    int handlerCount;                 ///< Number of handlers.
+    size_t recordSize;                ///< Size of each record (e.g., sizeof(Athlete)).
+    void (*finishRecord)(void *);     ///< Optional validation run on each parsed record.
+    char *records;                    ///< Parsed records, in file order.
+    int count;                        ///< Number of parsed records.
+    int capacity;                     ///< Capacity of 'records'.
+    bool internStrings;               ///< True if the records intern medal text fields.
+    PtStringPool strings[MEDAL_FIELD_COUNT]; ///< Dictionaries local to the chunk, when 'internStrings'.
+    bool failed;                      ///< True if the worker ran out of memory.
+} ImportChunk;
+
+// Dictionaries of the chunk being parsed by the current thread, set by parseChunk
+static _Thread_local PtStringPool *chunkStrings = NULL;
+
+/* ---------------------------- Athlete columns ---------------------------- */
+
+static void parseAthleteId(void *record, CsvField field) {
+    csvFieldCopy(field, ((Athlete*)record)->athleteID, MAX_ID_LENGTH);
+}
+
+static void parseAthleteName(void *record, CsvField field) {
+    csvFieldCopy(field, ((Athlete*)record)->athleteName, MAX_ATHLETE_NAME_LENGTH);
+    athleteSetNameKey((Athlete*)record);
+}
+
+static void parseAthleteParticipations(void *record, CsvField field) {
+    ((Athlete*)record)->gamesParticipations = csvFieldToInt(field);
+}
+
+static void parseAthleteFirstGame(void *record, CsvField field) {
+    char firstGame[MAX_FIRST_GAME_LENGTH];
+    csvFieldCopy(field, firstGame, MAX_FIRST_GAME_LENGTH);
+
+    ((Athlete*)record)->yearFirstParticipation = getNumbersFromString(firstGame);
+}
+
+static void parseAthleteBirth(void *record, CsvField field) {
+    ((Athlete*)record)->athleteBirth = csvFieldToInt(field);
+}
+
+static const CsvColumn athleteColumns[] = {
+    { "athlete_id", parseAthleteId },
+    { "athlete_full_name", parseAthleteName },
+    { "games_participations", parseAthleteParticipations },
+    { "first_game", parseAthleteFirstGame },
+    { "athlete_year_birth", parseAthleteBirth }
+};
+
+/* ----------------------------- Medal columns ----------------------------- */
+
+/**
+ * @brief Interns a text field of a medal into the dictionaries of the current chunk.
+ * The code is local to the chunk until the chunk is merged (see mergeMedalStrings).
+ * @param record The medal being parsed.
+ * @param medalField The field of the medal.
+ * @param field The value read from the file.
+ * @param maxLength Maximum length kept of the value (including the terminator).
+ */
+static void internMedalField(void *record, MedalField medalField, CsvField field, int maxLength) {
+    char value[MAX_EVENT_LENGTH];
+    csvFieldCopy(field, value, maxLength);
+
+    *medalFieldCode((Medal*)record, medalField) = stringPoolIntern(chunkStrings[medalField], value);
+}
+
+static void parseMedalDiscipline(void *record, CsvField field) {
+    internMedalField(record, MEDAL_DISCIPLINE, field, MAX_DISC_LENGTH);
+}
+
+static void parseMedalGame(void *record, CsvField field) {
+    internMedalField(record, MEDAL_GAME, field, MAX_GAME_LENGTH);
+}
+
+static void parseMedalEvent(void *record, CsvField field) {
+    internMedalField(record, MEDAL_EVENT, field, MAX_EVENT_LENGTH);
+}
+
+static void parseMedalGender(void *record, CsvField field) {
+    internMedalField(record, MEDAL_GENDER, field, MAX_GENDER);
+}
+
+static void parseMedalType(void *record, CsvField field) {
+    Medal *medal = (Medal*)record;
+
+    if(csvFieldEquals(field, "GOLD")) medal->medalType = 'G';
+    else if (csvFieldEquals(field, "SILVER")) medal->medalType = 'S';
+    else if (csvFieldEquals(field, "BRONZE")) medal->medalType = 'B';
+}
+
+static void parseMedalParticipantType(void *record, CsvField field) {
+    Medal *medal = (Medal*)record;
+
+    if(csvFieldEquals(field, "Athlete")) medal->participantType = 'A';
+    else if (csvFieldEquals(field, "GameTeam")) medal->participantType = 'G';
+}
+
+static void parseMedalAthleteId(void *record, CsvField field) {
+    csvFieldCopy(field, ((Medal*)record)->athleteID, MAX_ID_LENGTH);
+}
+
+static void parseMedalCountry(void *record, CsvField field) {
+    internMedalField(record, MEDAL_COUNTRY, field, MAX_COUNTRY_LENGTH);
+}
+
+static void finishMedal(void *record) {
+    Medal *medal = (Medal*)record;
+
+    // Validate athlete_id
+    if(medal->participantType == 'A' && strlen(medal->athleteID) == 0)
+        strcpy(medal->athleteID, "UNKNOWN");
+
+    // Resolved later by linkMedalHosts
+    medal->hostIndex = -1;
+}
+
+static const CsvColumn medalColumns[] = {
+    { "discipline_title", parseMedalDiscipline },
+    { "slug_game", parseMedalGame },
+    { "event_title", parseMedalEvent },
+    { "event_gender", parseMedalGender },
+    { "medal_type", parseMedalType },
+    { "participant_type", parseMedalParticipantType },
+    { "participant_title", NULL }, // We dont store this value
+    { "athlete_id", parseMedalAthleteId },
+    { "country_name", parseMedalCountry },
+    { "country_3_letter_code", NULL } // We dont store this value
+};
+
+/* ------------------------------ Host columns ----------------------------- */
+
+static void parseHostSlug(void *record, CsvField field) {
+    csvFieldCopy(field, ((Host*)record)->gameSlug, MAX_ID_LENGTH);
+}
+
+static void parseHostEndDate(void *record, CsvField field) {
+    csvFieldCopy(field, ((Host*)record)->endDate, MAX_HOST_NAME_LENGTH);
+}
+
+static void parseHostStartDate(void *record, CsvField field) {
+    csvFieldCopy(field, ((Host*)record)->startDate, MAX_HOST_NAME_LENGTH);
+}
+
+static void parseHostLocation(void *record, CsvField field) {
+    csvFieldCopy(field, ((Host*)record)->location, MAX_LOCATION_LENGTH);
+}
+
+static void parseHostName(void *record, CsvField field) {
+    csvFieldCopy(field, ((Host*)record)->gameName, MAX_GAME_NAME_LENGTH);
+}
+
+static void parseHostSeason(void *record, CsvField field) {
+    csvFieldCopy(field, ((Host*)record)->season, MAX_HOST_NAME_LENGTH);
+}
+
+static void parseHostYear(void *record, CsvField field) {
+    ((Host*)record)->year = csvFieldToInt(field);
+}
+
+static const CsvColumn hostColumns[] = {
+    { "game_slug", parseHostSlug },
+    { "game_end_date", parseHostEndDate },
+    { "game_start_date", parseHostStartDate },
+    { "game_location", parseHostLocation },
+    { "game_name", parseHostName },
+    { "game_season", parseHostSeason },
+    { "game_year", parseHostYear }
+};
+
+#define COLUMN_COUNT(columns) ((int)(sizeof(columns) / sizeof(columns[0])))
+
+/**
+ * @brief Reads the header row of a CSV file and resolves its handler table.
+ * @param reader Reader positioned at the start of the file.
+ * @param columns Known columns of the file.
+ * @param columnCount Number of known columns.
+ * @param handlers Array of MAX_FIELD_HEADERS entries that receives the handlers.
+ * @return Number of columns in the header, or -1 if an invalid column was found.
+ */
+static int readHeader(CsvReader *reader, const CsvColumn *columns, int columnCount, CsvFieldHandler *handlers) {
+    CsvField fieldHeaders[MAX_FIELD_HEADERS];
+    int headerCount = csvNextRecord(reader, fieldHeaders, MAX_FIELD_HEADERS);
+
+    if(headerCount == -1) return 0;
+    if(!csvResolveColumns(fieldHeaders, headerCount, columns, columnCount, handlers)) return -1;
+
+    return headerCount;
+}
+
+/**
+ * @brief Sets the number of worker threads used to parse large files.
+ * @param count Number of threads; values below 1 disable parallel parsing.
+ */
+void setImportThreadCount(int count) {
+    if(count < 1) count = 1;
+    if(count > MAX_IMPORT_THREADS) count = MAX_IMPORT_THREADS;
+
+    importThreadCount = count;
+}
+
+/**
+ * @brief Frees the buffers of parsed chunks.
+ * @param chunks Chunks to free.
+ * @param chunkCount Number of chunks.
+ */
+static void freeChunks(ImportChunk *chunks, int chunkCount) {
+    for(int i = 0; i < chunkCount; i++) {
+        free(chunks[i].records);
+
+        for(int f = 0; f < MEDAL_FIELD_COUNT; f++)
+            stringPoolDestroy(&chunks[i].strings[f]);
+    }
+
+    free(chunks);
+}
+
+/**
+ * @brief Counts the records of parsed chunks.
+ * @param chunks Parsed chunks.
+ * @param chunkCount Number of chunks.
+ * @return Total number of records.
+ */
+static int chunkRecordCount(const ImportChunk *chunks, int chunkCount) {
+    int count = 0;
+    for(int i = 0; i < chunkCount; i++) count += chunks[i].count;
+
+    return count;
+}
+
+/**
+ * @brief Parses every record of a chunk into the chunk's own buffer.
+ * @param arg Pointer to the ImportChunk to parse.
+ * @return Always NULL, errors are reported through the chunk.
+ */
+static void* parseChunk(void *arg) {
+    ImportChunk *chunk = (ImportChunk*)arg;
+
+    chunk->capacity = chunk->reader.size / ESTIMATED_BYTES_PER_ROW + 1;
+    chunk->records = malloc(chunk->capacity * chunk->recordSize);
+    if(chunk->records == NULL) {
+        chunk->failed = true;
+        return NULL;
+    }
+
+    // Code 0 of every dictionary is the empty string, like in the shared dictionaries
+    for(int f = 0; chunk->internStrings && f < MEDAL_FIELD_COUNT; f++) {
+        chunk->strings[f] = stringPoolCreate();
+        if(stringPoolIntern(chunk->strings[f], "") != MEDAL_EMPTY_CODE) {
+            chunk->failed = true;
+            return NULL;
+        }
+    }
+    chunkStrings = chunk->strings;
+
+    CsvField fields[MAX_FIELD_HEADERS];
+    int fieldCount;
+    while ((fieldCount = csvNextRecord(&chunk->reader, fields, MAX_FIELD_HEADERS)) != -1)
+    {
+        if(chunk->count == chunk->capacity) {
+            char *newRecords = realloc(chunk->records, chunk->capacity * 2 * chunk->recordSize);
+            if(newRecords == NULL) {
+                chunk->failed = true;
+                return NULL;
+            }
+
+            chunk->records = newRecords;
+            chunk->capacity *= 2;
+        }
+
+        void *record = chunk->records + chunk->count * chunk->recordSize;
+        memset(record, 0, chunk->recordSize);
+
+        csvApplyRecord(record, fields, fieldCount, chunk->handlers, chunk->handlerCount);
+        if(chunk->finishRecord != NULL) chunk->finishRecord(record);
+
+        chunk->count++;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Parses the remaining records of a file, splitting it across worker threads.
+ * The file is split into newline-aligned chunks, one per worker, and each worker
+ * fills its own buffer. Concatenating the chunks in order gives the rows in file order.
+ * @param reader Reader positioned after the header row.
+ * @param handlers Resolved column handlers.
+ * @param handlerCount Number of handlers.
+ * @param recordSize Size of each record.
+ * @param finishRecord Optional validation run on each parsed record.
+ * @param internStrings True if the handlers intern medal text fields into chunk dictionaries.
+ * @param ptChunkCount Address of variable to hold the number of chunks.
+ * @return Array of parsed chunks (freed with freeChunks), or NULL on failure.
+ */
+static ImportChunk* parseRecords(CsvReader *reader, const CsvFieldHandler *handlers, int handlerCount,
+                                 size_t recordSize, void (*finishRecord)(void *), bool internStrings,
+                                 int *ptChunkCount) {
+    int threads = importThreadCount;
+    size_t bodySize = reader->size - reader->position;
+
+    if(bodySize / MIN_CHUNK_BYTES < (size_t)threads) threads = bodySize / MIN_CHUNK_BYTES;
+    if(threads < 1) threads = 1;
+
+    CsvReader slices[MAX_IMPORT_THREADS];
+    int chunkCount = csvSplit(reader, threads, slices);
+
+    ImportChunk *chunks = calloc(chunkCount > 0 ? chunkCount : 1, sizeof(ImportChunk));
+    if(chunks == NULL) return NULL;
+
+    for(int i = 0; i < chunkCount; i++) {
+        chunks[i].reader = slices[i];
+        chunks[i].handlers = handlers;
+        chunks[i].handlerCount = handlerCount;
+        chunks[i].recordSize = recordSize;
+        chunks[i].finishRecord = finishRecord;
+        chunks[i].internStrings = internStrings;
+    }
+
+    // The first chunk is parsed by the calling thread
+    pthread_t workers[MAX_IMPORT_THREADS];
+    bool started[MAX_IMPORT_THREADS] = { false };
+    for(int i = 1; i < chunkCount; i++)
+        started[i] = pthread_create(&workers[i], NULL, parseChunk, &chunks[i]) == 0;
+
+    if(chunkCount > 0) parseChunk(&chunks[0]);
+
+    bool failed = false;
+    for(int i = 1; i < chunkCount; i++) {
+        if(started[i]) pthread_join(workers[i], NULL);
+        else parseChunk(&chunks[i]); // Could not start a thread, parse it here instead
+    }
+
+    for(int i = 0; i < chunkCount; i++)
+        failed = failed || chunks[i].failed;
+
+    *ptChunkCount = chunkCount;
+
+    if(failed) {
+        freeChunks(chunks, chunkCount);
+        return NULL;
+    }
+
+    return chunks;
+}
+
+/**
+ * @brief Replaces the chunk-local codes of the medals of a chunk with codes of the shared dictionaries.
+ * @param chunk A parsed chunk of medals.
+ * @return True if successful, false on memory allocation failure.
+ */
+static bool mergeMedalStrings(ImportChunk *chunk) {
+    Medal *records = (Medal*)chunk->records;
+    bool ok = true;
+
+    for(int f = 0; f < MEDAL_FIELD_COUNT && ok; f++) {
+        int localCount = stringPoolSize(chunk->strings[f]);
+        int *globalCodes = malloc((localCount > 0 ? localCount : 1) * sizeof(int));
+        if(globalCodes == NULL) return false;
+
+        for(int c = 0; c < localCount && ok; c++) {
+            globalCodes[c] = medalIntern(f, stringPoolGet(chunk->strings[f], c));
+            ok = globalCodes[c] != STRING_POOL_NO_CODE;
+        }
+
+        for(int j = 0; j < chunk->count && ok; j++) {
+            int *code = medalFieldCode(&records[j], f);
+
+            // A code out of range means interning failed while parsing
+            ok = *code >= 0 && *code < localCount;
+            if(ok) *code = globalCodes[*code];
+        }
+
+        free(globalCodes);
+    }
+
+    return ok;
+}
 
 /**
  * @brief Imports athletes from a CSV file into a list.
  * @return A list of athletes or NULL if the file cannot be opened or parsed.
  */
 PtList importAthletes() {
-    PtList athletes = listCreate();
+    // Skip parsing if the CSV did not change since the last snapshot
+    PtList athletes = snapshotLoadAthletes(ATHLETES_FILE);
+    if(athletes != NULL) return athletes;
 
-    FILE* fs = fopen("data/athletes.csv", "r");
-    
-    if(fs == NULL) {
+    CsvReader reader;
+    if(!csvOpen(&reader, ATHLETES_FILE)) {
         printf("Error opening athletes.csv\n");
         return NULL;
     }
 
-    char line[MAX_LINE_LENGTH];
-    char *fieldHeaders[MAX_FIELD_HEADERS];
-    bool isFirst = true;
-    while (fgets(line, MAX_LINE_LENGTH, fs))
-    {
-        char* tempLine = strdup(line);
-
-        // Trim line endings
-        tempLine[strcspn(line, "\n")] = '\0';
-        
-        Athlete *athlete = createEmptyAthlete();
-
-        int field_count = 0;
-        char *token = strtok(tempLine, ";");
-        while (token && field_count < MAX_FIELD_HEADERS) {
-            if(isFirst) // Map columns to indexes in first line
-                fieldHeaders[field_count] = token;
-            else { // Map values to object in other lines
-                if(strcmp(fieldHeaders[field_count], "athlete_id") == 0) {
-                    strcpy(athlete->athleteID, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "athlete_full_name") == 0) {
-                    strcpy(athlete->athleteName, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "games_participations") == 0) {
-                    athlete->gamesParticipations = atoi(token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "first_game") == 0) {
-                    athlete->yearFirstParticipation = getNumbersFromString(token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "athlete_year_birth") == 0) {
-                    if(strlen(token) == 0) athlete->athleteBirth = 0;
-                    else athlete->athleteBirth = atoi(token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "") != 0) {
-                    printf("Found invalid column in athletes.csv\n");
-                    return NULL;
-                }
-            }            
-            
-            field_count++;
-            token = strtok(NULL, ";"); // Read next token
-        }
-        
-        // Add record to list
-        if(!isFirst) {
-            // Get index to add to
-            int athleteCount = 0;
-            listSize(athletes, &athleteCount);
-
-            // Add to list
-            listAdd(athletes, athleteCount, *athlete);
-        }
-        
-        isFirst = false;
-        
-        //free(tempLine);
-        free(token);
+    CsvFieldHandler handlers[MAX_FIELD_HEADERS];
+    int headerCount = readHeader(&reader, athleteColumns, COLUMN_COUNT(athleteColumns), handlers);
+    if(headerCount == -1) {
+        printf("Found invalid column in athletes.csv\n");
+        csvClose(&reader);
+        return NULL;
+    }
+
+    int chunkCount = 0;
+    ImportChunk *chunks = parseRecords(&reader, handlers, headerCount, sizeof(Athlete), NULL, false, &chunkCount);
+    csvClose(&reader);
+
+    if(chunks == NULL) {
+        printf("Not enough memory to import athletes.csv\n");
+        return NULL;
+    }
+
+    // Concatenate the chunks in file order, into a list sized for all of them
+    athletes = listCreate();
+    bool appended = athletes != NULL && listReserve(athletes, chunkRecordCount(chunks, chunkCount)) == LIST_OK;
+    for(int i = 0; i < chunkCount && appended; i++)
+        appended = listAppendN(athletes, (Athlete*)chunks[i].records, chunks[i].count) == LIST_OK;
+
+    freeChunks(chunks, chunkCount);
+
+    if(!appended) {
+        printf("Not enough memory to import athletes.csv\n");
+        listDestroy(&athletes);
+        return NULL;
     }
 
+    snapshotSaveAthletes(athletes, ATHLETES_FILE);
+
     return athletes;
 }
 
@@ -105,97 +481,56 @@ PtList importAthletes() {
  * @return A list of medals or NULL if the file cannot be opened or parsed.
  */
 PtListMedal importMedals(){
-    PtListMedal medals = listMedalCreate();
+    // Skip parsing if the CSV did not change since the last snapshot
+    PtListMedal medals = snapshotLoadMedals(MEDALS_FILE);
+    if(medals != NULL) {
+        listMedalIndexAthletes(medals);
+        return medals;
+    }
 
-    FILE* fs = fopen("data/medals.csv", "r");
-    
-    if(fs == NULL) {
+    CsvReader reader;
+    if(!csvOpen(&reader, MEDALS_FILE)) {
         printf("Error opening medals.csv\n");
         return NULL;
     }
 
-    char line[MAX_LINE_LENGTH];
-    char *fieldHeaders[MAX_FIELD_HEADERS];
-    bool isFirst = true;
-    while (fgets(line, MAX_LINE_LENGTH, fs))
-    {
-        char* tempLine = strdup(line);
-
-        // Trim line endings
-        tempLine[strcspn(line, "\n")] = '\0';
-        tempLine[strcspn(line, "\r")] = '\0';
-        
-        Medal *medal = createEmptyMedal();
-
-        int field_count = 0;
-        char *token = strtok(tempLine, ";");
-        while (token && field_count < MAX_FIELD_HEADERS) {
-            if(isFirst) // Map columns to indexes in first line
-                fieldHeaders[field_count] = token;
-            else { // Map values to object in other lines
-                if(strcmp(fieldHeaders[field_count], "discipline_title") == 0) {
-                    strcpy(medal->discipline, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "slug_game") == 0) {
-                    strcpy(medal->game, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "event_title") == 0) {
-                    strcpy(medal->eventTitle, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "event_gender") == 0) {
-                    strcpy(medal->gender, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "medal_type") == 0) {
-                    if(strcmp(token, "GOLD") == 0) medal->medalType = 'G';
-                    else if (strcmp(token, "SILVER") == 0) medal->medalType = 'S';
-                    else if (strcmp(token, "BRONZE") == 0) medal->medalType = 'B';
-                }
-                else if(strcmp(fieldHeaders[field_count], "participant_type") == 0) {
-                    if(strcmp(token, "Athlete") == 0) medal->participantType = 'A';
-                    else if (strcmp(token, "GameTeam") == 0) medal->participantType = 'G';
-                }
-                else if(strcmp(fieldHeaders[field_count], "participant_title") == 0) {
-                    // Do nothing, we dont store this value
-                }
-                else if(strcmp(fieldHeaders[field_count], "athlete_id") == 0) {
-                    strcpy(medal->athleteID, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "country_name") == 0) {
-                    strcpy(medal->country, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "country_3_letter_code") == 0) {
-                    // Do nothing, we dont store this value
-                }
-                else if(strcmp(fieldHeaders[field_count], "") != 0) {
-                    printf("Found invalid column in athletes.csv\n");
-                    return NULL;
-                }
-            }
+    CsvFieldHandler handlers[MAX_FIELD_HEADERS];
+    int headerCount = readHeader(&reader, medalColumns, COLUMN_COUNT(medalColumns), handlers);
+    if(headerCount == -1) {
+        printf("Found invalid column in medals.csv\n");
+        csvClose(&reader);
+        return NULL;
+    }
 
-            // Validate athlete_id
-            if(medal->participantType == 'A' && strlen(medal->athleteID) == 0)
-                strcpy(medal->athleteID, "UNKNOWN");
-            
-            field_count++;
-            token = strtok(NULL, ";"); // Read next token
-        }
-        
-        // Add record to list
-        if(!isFirst) {
-            // Get index to add to
-            int medalCount = 0;
-            listSize(medals, &medalCount);
-
-            // Add to list
-            listMedalAdd(medals, medalCount, *medal);
-        }
-        
-        isFirst = false;
-        
-        //free(tempLine);
-        free(token);
+    int chunkCount = 0;
+    ImportChunk *chunks = parseRecords(&reader, handlers, headerCount, sizeof(Medal), finishMedal, true, &chunkCount);
+    csvClose(&reader);
+
+    if(chunks == NULL) {
+        printf("Not enough memory to import medals.csv\n");
+        return NULL;
     }
 
+    // Concatenate the chunks in file order, into a list sized for all of them
+    medals = listMedalCreate();
+    bool merged = medals != NULL && listMedalReserve(medals, chunkRecordCount(chunks, chunkCount)) == LIST_OK;
+    for(int i = 0; i < chunkCount && merged; i++)
+        merged = mergeMedalStrings(&chunks[i])
+            && listMedalAppendN(medals, (Medal*)chunks[i].records, chunks[i].count) == LIST_OK;
+
+    freeChunks(chunks, chunkCount);
+
+    if(!merged) {
+        printf("Not enough memory to import medals.csv\n");
+        listMedalDestroy(&medals);
+        return NULL;
+    }
+
+    // Per-athlete queries read the rows of each athlete from this index
+    listMedalIndexAthletes(medals);
+
+    snapshotSaveMedals(medals, MEDALS_FILE);
+
     return medals;
 }
 
@@ -204,73 +539,140 @@ PtListMedal importMedals(){
  * @return A map of hosts indexed by game slug or NULL if the file cannot be opened or parsed.
  */
 PtMap importHosts(){
-    PtMap hosts = mapCreate();
+    // Skip parsing if the CSV did not change since the last snapshot
+    PtMap hosts = snapshotLoadHosts(HOSTS_FILE);
+    if(hosts != NULL) return hosts;
 
-    FILE* fs = fopen("data/hosts.csv", "r");
-    
-    if(fs == NULL) {
+    CsvReader reader;
+    if(!csvOpen(&reader, HOSTS_FILE)) {
         printf("Error opening hosts.csv\n");
         return NULL;
     }
 
-    char line[MAX_LINE_LENGTH];
-    char *fieldHeaders[MAX_FIELD_HEADERS];
-    bool isFirst = true;
-    while (fgets(line, MAX_LINE_LENGTH, fs))
+    CsvFieldHandler handlers[MAX_FIELD_HEADERS];
+    int headerCount = readHeader(&reader, hostColumns, COLUMN_COUNT(hostColumns), handlers);
+    if(headerCount == -1) {
+        printf("Found invalid column in hosts.csv\n");
+        csvClose(&reader);
+        return NULL;
+    }
+
+    hosts = mapCreate();
+
+    CsvField fields[MAX_FIELD_HEADERS];
+    int fieldCount;
+    while ((fieldCount = csvNextRecord(&reader, fields, MAX_FIELD_HEADERS)) != -1)
     {
-        char* tempLine = strdup(line);
-
-        // Trim line endings
-        tempLine[strcspn(line, "\n")] = '\0';
-        
-        Host *host = createEmptyHost();
-
-        int field_count = 0;
-        char *token = strtok(tempLine, ";");
-        while (token && field_count < MAX_FIELD_HEADERS) {
-            if(isFirst) // Map columns to indexes in first line
-                fieldHeaders[field_count] = token;
-            else { // Map values to object in other lines
-                if(strcmp(fieldHeaders[field_count], "game_slug") == 0) {
-                    strcpy(host->gameSlug, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "game_end_date") == 0) {
-                    strcpy(host->endDate, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "game_start_date") == 0) {
-                    strcpy(host->startDate, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "game_location") == 0) {
-                    strcpy(host->location, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "game_name") == 0) {
-                    strcpy(host->gameName, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "game_season") == 0) {
-                    strcpy(host->season, token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "game_year") == 0) {
-                    host->year = atoi(token);
-                }
-                else if(strcmp(fieldHeaders[field_count], "") != 0) {
-                    printf("Found invalid column in athletes.csv\n");
-                    return NULL;
-                }
-            }            
-            
-            field_count++;
-            token = strtok(NULL, ";"); // Read next token
-        }
-        
-        // Add record to map
-        if(!isFirst)
-            mapPut(hosts, host->gameSlug, *host);
-        
-        isFirst = false;
-        
-        //free(tempLine);
-        free(token);
+        Host host;
+        memset(&host, 0, sizeof(Host));
+
+        csvApplyRecord(&host, fields, fieldCount, handlers, headerCount);
+        computeHostDates(&host);
+
+        // Add record to map (the map keeps its own copy of the key)
+        mapPut(hosts, host.gameSlug, host);
     }
 
+    csvClose(&reader);
+
+    snapshotSaveHosts(hosts, HOSTS_FILE);
+
     return hosts;
 }
+
+/**
+ * @brief Links every medal to the host of its game, storing the host index in the medal.
+ * @param medals The medals to link.
+ * @param hosts The hosts, or NULL to unlink every medal.
+ * @return Number of medals whose host was found.
+ */
+int linkMedalHosts(PtListMedal medals, PtMap hosts) {
+    int size = 0, linked = 0;
+    listMedalSize(medals, &size);
+
+    // Medals of the same game usually come together, remember the last one resolved
+    int lastGame = STRING_POOL_NO_CODE;
+    int lastIndex = -1;
+
+    MedalColumns columns;
+    listMedalColumns(medals, &columns);
+
+    for(int i = 0; i < size; i++) {
+        if(columns.game[i] != lastGame) {
+            lastGame = columns.game[i];
+            if(mapIndexOf(hosts, (MapKey)medalString(MEDAL_GAME, lastGame), &lastIndex) != MAP_OK) lastIndex = -1;
+        }
+
+        if(lastIndex != -1) linked++;
+        if(columns.hostIndex[i] == lastIndex) continue;
+
+        // Changing the host leaves the columns in place, the views stay valid
+        Medal medal;
+        listMedalGet(medals, i, &medal);
+        medal.hostIndex = lastIndex;
+        listMedalSet(medals, i, medal, NULL);
+    }
+
+    return linked;
+}
+
+static void* importAthletesWorker(void *arg) {
+    *(PtList*)arg = importAthletes();
+    return NULL;
+}
+
+static void* importMedalsWorker(void *arg) {
+    *(PtListMedal*)arg = importMedals();
+    return NULL;
+}
+
+static void* importHostsWorker(void *arg) {
+    *(PtMap*)arg = importHosts();
+    return NULL;
+}
+
+/**
+ * @brief Imports athletes, medals and hosts at the same time, each on its own thread.
+ * @param ptAthletes Address of variable to hold the imported athletes (NULL on failure).
+ * @param ptMedals Address of variable to hold the imported medals (NULL on failure).
+ * @param ptHosts Address of variable to hold the imported hosts (NULL on failure).
+ * @return True if all three files were imported, false otherwise.
+ */
+bool importAll(PtList *ptAthletes, PtListMedal *ptMedals, PtMap *ptHosts) {
+    *ptAthletes = NULL;
+    *ptMedals = NULL;
+    *ptHosts = NULL;
+
+    pthread_t athletesThread, medalsThread, hostsThread;
+    bool athletesStarted = pthread_create(&athletesThread, NULL, importAthletesWorker, ptAthletes) == 0;
+    bool medalsStarted = pthread_create(&medalsThread, NULL, importMedalsWorker, ptMedals) == 0;
+    bool hostsStarted = pthread_create(&hostsThread, NULL, importHostsWorker, ptHosts) == 0;
+
+    // Whatever could not be started is imported on the calling thread
+    if(hostsStarted) pthread_join(hostsThread, NULL);
+    else importHostsWorker(ptHosts);
+
+    if(athletesStarted) pthread_join(athletesThread, NULL);
+    else importAthletesWorker(ptAthletes);
+
+    if(medalsStarted) pthread_join(medalsThread, NULL);
+    else importMedalsWorker(ptMedals);
+
+    return *ptAthletes != NULL && *ptMedals != NULL && *ptHosts != NULL;
+}
+
+/**
+ * @brief Loads every data set that has an up-to-date snapshot, without parsing any CSV file.
+ * @param ptAthletes Address of variable to hold the athletes (NULL if there is no valid snapshot).
+ * @param ptMedals Address of variable to hold the medals (NULL if there is no valid snapshot).
+ * @param ptHosts Address of variable to hold the hosts (NULL if there is no valid snapshot).
+ * @return True if at least one data set was restored, false otherwise.
+ */
+bool importFromSnapshots(PtList *ptAthletes, PtListMedal *ptMedals, PtMap *ptHosts) {
+    *ptAthletes = snapshotLoadAthletes(ATHLETES_FILE);
+    *ptMedals = snapshotLoadMedals(MEDALS_FILE);
+    if(*ptMedals != NULL) listMedalIndexAthletes(*ptMedals);
+    *ptHosts = snapshotLoadHosts(HOSTS_FILE);
+
+    return *ptAthletes != NULL || *ptMedals != NULL || *ptHosts != NULL;
+}
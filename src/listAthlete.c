@@ -4,31 +4,157 @@
  * @brief Provides an implementation of the ADT List with an array list
  * as the underlying data structure.
  * 
+ * The array is double-ended: the elements occupy a contiguous range of
+ * slots with free room on both sides. Adding or removing at either end is
+ * amortized O(1), and in the middle only the shorter side of the list is
+ * moved, with a single memmove.
+ * 
+ * The list also maintains a hash index (open addressing, linear probing)
+ * from athlete ID to slot, kept in sync by every operation that changes
+ * the list, so athletes can be found by ID in O(1) expected time.
+ * 
+ * A sorted order of the ranks (see listSortedOrder) is computed on demand
+ * and cached until the list changes, so repeated ordered views of the same
+ * list do not sort it again. Orders with a key are sorted by radix on the
+ * keys (see sortKeyWords), and only elements with equal keys are compared.
+ * 
  * @author Raul Rohajns
  */
 
 #include "list.h"
 #include "athlete.h"
+#include "helpers.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define INITIAL_CAPACITY 20
+#define INITIAL_ID_SLOTS 64 ///< Must be a power of two.
+
+#define EMPTY_SLOT -1       ///< Slot never used.
+#define DELETED_SLOT -2     ///< Slot whose athlete was removed.
+
+#define INSERTION_SORT_THRESHOLD 16  ///< Ranges up to this size are sorted by insertion.
 
 typedef struct listImpl {
 	ListElem *elements;
+    int head;         ///< Slot of the element of rank 0, elements occupy [head, head + size).
     int size;
-    int capacity;
+    int capacity;     ///< Number of slots of 'elements'.
+    int *idSlots;     ///< Athlete ID index: slot in 'elements', EMPTY_SLOT or DELETED_SLOT.
+    int idSlotCount;  ///< Number of slots, always a power of two.
+    int idUsedSlots;  ///< Slots that are not EMPTY_SLOT.
+    int *order;       ///< Cached ranks in sorted order, or NULL if out of date.
+    ListElemKey orderKey;             ///< Key function of 'order', or NULL if sorted by comparisons only.
+    ListElemComparator orderCompare;  ///< Comparison function of 'order'.
 } ListImpl;
 
 /**
- * @brief Ensures the capacity of the list to store more elements.
+ * @brief Drops the cached sorted order, after any change to the list.
  * @param list Pointer to the list.
- * @return True if capacity is sufficient or successfully expanded, False on memory allocation failure.
  */
-static bool ensureCapacity(PtList list) {
-    if (list->size < list->capacity) return true;
-    
-    int newCapacity = list->capacity * 2;
+static void invalidateOrder(PtList list) {
+    free(list->order);
+    list->order = NULL;
+}
+
+/**
+ * @brief Adds the athlete in a slot of 'elements' to the ID index.
+ * @param list Pointer to the list.
+ * @param slot Slot of the athlete.
+ */
+static void indexInsert(PtList list, int slot) {
+    int mask = list->idSlotCount - 1;
+
+    int i = hashString(list->elements[slot].athleteID) & mask;
+    while (list->idSlots[i] >= 0) i = (i + 1) & mask;
+
+    if (list->idSlots[i] == EMPTY_SLOT) list->idUsedSlots++;
+    list->idSlots[i] = slot;
+}
+
+/**
+ * @brief Removes the athlete in a slot of 'elements' from the ID index.
+ * @param list Pointer to the list.
+ * @param slot Slot of the athlete.
+ */
+static void indexRemove(PtList list, int slot) {
+    int mask = list->idSlotCount - 1;
+
+    for (int i = hashString(list->elements[slot].athleteID) & mask; list->idSlots[i] != EMPTY_SLOT; i = (i + 1) & mask) {
+        if (list->idSlots[i] == slot) {
+            list->idSlots[i] = DELETED_SLOT;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Refills the ID index from scratch, keeping its number of slots.
+ * @param list Pointer to the list.
+ */
+static void indexRefill(PtList list) {
+    for (int i = 0; i < list->idSlotCount; i++) list->idSlots[i] = EMPTY_SLOT;
+    list->idUsedSlots = 0;
+
+    for (int i = 0; i < list->size; i++) indexInsert(list, list->head + i);
+}
+
+/**
+ * @brief Rebuilds the ID index from scratch, growing it if needed.
+ * @param list Pointer to the list.
+ * @param minSize Number of athletes the index must be able to hold.
+ * @return True if successful, False on memory allocation failure.
+ */
+static bool indexRebuild(PtList list, int minSize) {
+    int slotCount = list->idSlotCount;
+    while (minSize * 2 > slotCount) slotCount *= 2;
+
+    if (slotCount != list->idSlotCount) {
+        int *newSlots = (int*) malloc(slotCount * sizeof(int));
+        if (newSlots == NULL) return false;
+
+        free(list->idSlots);
+        list->idSlots = newSlots;
+        list->idSlotCount = slotCount;
+    }
+
+    indexRefill(list);
+
+    return true;
+}
+
+/**
+ * @brief Ensures the ID index has room for one more athlete.
+ * @param list Pointer to the list.
+ * @return True if successful, False on memory allocation failure.
+ */
+static bool ensureIndexCapacity(PtList list) {
+    // Keep the index at most 3/4 full, counting deleted slots
+    if ((list->idUsedSlots + 1) * 4 <= list->idSlotCount * 3) return true;
+
+    return indexRebuild(list, list->size + 1);
+}
+
+/**
+ * @brief Ensures there are free slots before the first element and after the last one.
+ * 
+ * An end that is too short grows by at least the size of the list, so
+ * repeated pushes at either end are amortized O(1).
+ * 
+ * @param list Pointer to the list.
+ * @param front Number of free slots needed before the first element.
+ * @param back Number of free slots needed after the last element.
+ * @return True if there is enough room or the array was expanded, False on memory allocation failure.
+ */
+static bool reserveSlots(PtList list, int front, int back) {
+    int frontRoom = list->head;
+    int backRoom = list->capacity - list->head - list->size;
+    if (frontRoom >= front && backRoom >= back) return true;
+
+    int head = frontRoom >= front ? frontRoom : (front > list->size ? front : list->size);
+    int backSlots = backRoom >= back ? backRoom : (back > list->size ? back : list->size);
+    int newCapacity = head + list->size + backSlots;
 
     ListElem *newElements = (ListElem*) realloc(list->elements, newCapacity * sizeof(ListElem));
     
@@ -36,10 +162,186 @@ static bool ensureCapacity(PtList list) {
 
     list->capacity = newCapacity;
     list->elements = newElements;
+
+    // Growing the front moves every element to other slots
+    if (head != list->head) {
+        memmove(list->elements + head, list->elements + list->head, list->size * sizeof(ListElem));
+        list->head = head;
+        indexRefill(list);
+    }
     
     return true;
 }
 
+/**
+ * @brief Moves elements to other slots, keeping the ID index in sync.
+ * @param list Pointer to the list.
+ * @param to First destination slot.
+ * @param from First source slot.
+ * @param count Number of elements to move.
+ * @return True if the index was updated, False if it must be refilled once the list is consistent again.
+ */
+static bool moveElements(PtList list, int to, int from, int count) {
+    // Re-keying reuses the slots it frees, but must not push the index past 3/4 meanwhile
+    bool rekey = (list->idUsedSlots + count + 1) * 4 <= list->idSlotCount * 3;
+
+    if (rekey)
+        for (int i = 0; i < count; i++) indexRemove(list, from + i);
+
+    memmove(list->elements + to, list->elements + from, count * sizeof(ListElem));
+
+    if (rekey)
+        for (int i = 0; i < count; i++) indexInsert(list, to + i);
+
+    return rekey;
+}
+
+/**
+ * @brief Compares the athletes in two slots of 'elements', breaking ties by slot.
+ * The tie-break makes every key distinct and the sort stable.
+ * @param list Pointer to the list.
+ * @param compare Comparison function.
+ * @param a First slot.
+ * @param b Second slot.
+ * @return Negative if 'a' comes first, positive otherwise (zero only if a == b).
+ */
+static int compareSlots(PtList list, ListElemComparator compare, int a, int b) {
+    int result = compare(&list->elements[a], &list->elements[b]);
+    if (result != 0) return result;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Swaps two entries of an array of slots.
+ * @param slots The array.
+ * @param i First position.
+ * @param j Second position.
+ */
+static void swapSlots(int *slots, int i, int j) {
+    int tmp = slots[i];
+    slots[i] = slots[j];
+    slots[j] = tmp;
+}
+
+/**
+ * @brief Sorts a small array of slots by insertion.
+ * @param list Pointer to the list.
+ * @param compare Comparison function.
+ * @param slots Slots to sort.
+ * @param count Number of slots.
+ */
+static void insertionSortSlots(PtList list, ListElemComparator compare, int *slots, int count) {
+    for (int i = 1; i < count; i++) {
+        int slot = slots[i];
+
+        int j = i;
+        for (; j > 0 && compareSlots(list, compare, slots[j - 1], slot) > 0; j--) slots[j] = slots[j - 1];
+
+        slots[j] = slot;
+    }
+}
+
+/**
+ * @brief Restores the heap property downwards in a max-heap of slots.
+ * @param list Pointer to the list.
+ * @param compare Comparison function.
+ * @param slots The heap.
+ * @param count Number of slots in the heap.
+ * @param i Position to sift down from.
+ */
+static void siftDownSlots(PtList list, ListElemComparator compare, int *slots, int count, int i) {
+    while (true) {
+        int largest = i, left = 2 * i + 1, right = 2 * i + 2;
+
+        if (left < count && compareSlots(list, compare, slots[left], slots[largest]) > 0) largest = left;
+        if (right < count && compareSlots(list, compare, slots[right], slots[largest]) > 0) largest = right;
+        if (largest == i) return;
+
+        swapSlots(slots, i, largest);
+        i = largest;
+    }
+}
+
+/**
+ * @brief Sorts an array of slots with heap sort.
+ * @param list Pointer to the list.
+ * @param compare Comparison function.
+ * @param slots Slots to sort.
+ * @param count Number of slots.
+ */
+static void heapSortSlots(PtList list, ListElemComparator compare, int *slots, int count) {
+    for (int i = count / 2 - 1; i >= 0; i--) siftDownSlots(list, compare, slots, count, i);
+
+    for (int end = count - 1; end > 0; end--) {
+        swapSlots(slots, 0, end);
+        siftDownSlots(list, compare, slots, end, 0);
+    }
+}
+
+/**
+ * @brief Sorts an array of slots with introsort: quicksort with a median of
+ * three pivot, falling back to heap sort when partitions keep being unbalanced.
+ * @param list Pointer to the list.
+ * @param compare Comparison function.
+ * @param slots Slots to sort.
+ * @param count Number of slots.
+ * @param depthLimit Number of partitioning levels left before falling back to heap sort.
+ */
+static void introSortSlots(PtList list, ListElemComparator compare, int *slots, int count, int depthLimit) {
+    while (count > INSERTION_SORT_THRESHOLD) {
+        if (depthLimit-- == 0) {
+            heapSortSlots(list, compare, slots, count);
+            return;
+        }
+
+        // Order first, middle and last, the middle one becomes the pivot
+        int mid = count / 2;
+        if (compareSlots(list, compare, slots[mid], slots[0]) < 0) swapSlots(slots, mid, 0);
+        if (compareSlots(list, compare, slots[count - 1], slots[0]) < 0) swapSlots(slots, count - 1, 0);
+        if (compareSlots(list, compare, slots[count - 1], slots[mid]) < 0) swapSlots(slots, count - 1, mid);
+        int pivot = slots[mid];
+
+        // Hoare partition into [0, j] and [j + 1, count)
+        int i = -1, j = count;
+        while (true) {
+            do i++; while (compareSlots(list, compare, slots[i], pivot) < 0);
+            do j--; while (compareSlots(list, compare, slots[j], pivot) > 0);
+            if (i >= j) break;
+
+            swapSlots(slots, i, j);
+        }
+
+        // Recurse into the smaller part and loop on the larger one, so the stack stays O(log n)
+        int leftCount = j + 1;
+        if (leftCount < count - leftCount) {
+            introSortSlots(list, compare, slots, leftCount, depthLimit);
+            slots += leftCount;
+            count -= leftCount;
+        }
+        else {
+            introSortSlots(list, compare, slots + leftCount, count - leftCount, depthLimit);
+            count = leftCount;
+        }
+    }
+
+    insertionSortSlots(list, compare, slots, count);
+}
+
+/**
+ * @brief Sorts an array of slots by the athletes they hold (stable, O(n log n)).
+ * @param list Pointer to the list.
+ * @param compare Comparison function.
+ * @param slots Slots to sort.
+ * @param count Number of slots.
+ */
+static void sortSlots(PtList list, ListElemComparator compare, int *slots, int count) {
+    int depthLimit = 0;
+    for (int n = count; n > 1; n >>= 1) depthLimit += 2;
+
+    introSortSlots(list, compare, slots, count, depthLimit);
+}
+
 /**
  * @brief Creates a new list for storing athletes.
  * @return Pointer to the created list or NULL if memory allocation fails.
@@ -50,14 +352,25 @@ PtList listCreate() {
     if (list == NULL) return NULL;
 
     list->elements = malloc(INITIAL_CAPACITY * sizeof(ListElem));
+    list->idSlots = malloc(INITIAL_ID_SLOTS * sizeof(int));
     
-	if (list->elements == NULL) {
+	if (list->elements == NULL || list->idSlots == NULL) {
+        free(list->elements);
+        free(list->idSlots);
         free(list);
         return NULL;
     }
 
+    for (int i = 0; i < INITIAL_ID_SLOTS; i++) list->idSlots[i] = EMPTY_SLOT;
+
+    list->head = 0;
     list->size = 0;
     list->capacity = INITIAL_CAPACITY;
+    list->idSlotCount = INITIAL_ID_SLOTS;
+    list->idUsedSlots = 0;
+    list->order = NULL;
+    list->orderKey = NULL;
+    list->orderCompare = NULL;
 
     return list;
 }
@@ -70,12 +383,12 @@ PtList listCreate() {
 int listDestroy(PtList *ptList) {
 	if (ptList == NULL || *ptList == NULL) return LIST_NULL;
 
-    ListImpl *list = (ListImpl *)ptList;
+    ListImpl *list = *ptList;
 
     free(list->elements);
-
-    // This throws an exception
-	//free(list);
+    free(list->idSlots);
+    free(list->order);
+	free(list);
 
     *ptList = NULL;
 
@@ -92,15 +405,188 @@ int listDestroy(PtList *ptList) {
 int listAdd(PtList list, int rank, ListElem elem) {
 	if (list == NULL) return LIST_NULL;
     if (rank < 0 || rank > ((ListImpl *)list)->size) return LIST_INVALID_RANK;
-    if (!ensureCapacity(list)) return LIST_NO_MEMORY;
 
-    // Make space for the new element
-    for (int i = list->size; i > rank; i--)
-        list->elements[i] = list->elements[i - 1];
+    // Make space by moving whichever side of 'rank' has fewer elements
+    bool shiftFront = rank < list->size - rank;
+    if (!reserveSlots(list, shiftFront ? 1 : 0, shiftFront ? 0 : 1) || !ensureIndexCapacity(list))
+        return LIST_NO_MEMORY;
+
+    invalidateOrder(list);
+
+    bool indexed;
+    if (shiftFront) {
+        indexed = moveElements(list, list->head - 1, list->head, rank);
+        list->head--;
+    }
+    else indexed = moveElements(list, list->head + rank + 1, list->head + rank, list->size - rank);
     
-    list->elements[rank] = elem;
+    list->elements[list->head + rank] = elem;
     list->size++;
 
+    if (indexed) indexInsert(list, list->head + rank);
+    else indexRefill(list);
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Reserves room in the list, and in its ID index, for a number of athletes.
+ * @param list Pointer to the list.
+ * @param capacity Number of athletes to reserve room for.
+ * @return LIST_OK if successful, LIST_NULL if the list is NULL, or LIST_NO_MEMORY if memory allocation fails.
+ */
+int listReserve(PtList list, int capacity) {
+	if (list == NULL) return LIST_NULL;
+    if (!reserveSlots(list, 0, capacity - list->size)) return LIST_NO_MEMORY;
+
+    // Same load limit as ensureIndexCapacity, so appending never rehashes
+    if (capacity * 4 > list->idSlotCount * 3 && !indexRebuild(list, capacity)) return LIST_NO_MEMORY;
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Adds an element at the end of the list.
+ * @param list Pointer to the list.
+ * @param elem The element to be appended.
+ * @return LIST_OK if successful, LIST_NULL if the list is NULL, or LIST_NO_MEMORY if memory allocation fails.
+ */
+int listAppend(PtList list, ListElem elem) {
+	if (list == NULL) return LIST_NULL;
+    if (!reserveSlots(list, 0, 1) || !ensureIndexCapacity(list)) return LIST_NO_MEMORY;
+
+    invalidateOrder(list);
+
+    int slot = list->head + list->size++;
+    list->elements[slot] = elem;
+    indexInsert(list, slot);
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Adds an array of elements at the end of the list, in order.
+ * @param list Pointer to the list.
+ * @param elems The elements to be appended.
+ * @param count Number of elements.
+ * @return LIST_OK if successful, LIST_NULL if the list or the elements are NULL, or LIST_NO_MEMORY if memory allocation fails.
+ */
+int listAppendN(PtList list, const ListElem *elems, int count) {
+	if (list == NULL || elems == NULL) return LIST_NULL;
+    if (count <= 0) return LIST_OK;
+    if (listReserve(list, list->size + count) != LIST_OK) return LIST_NO_MEMORY;
+
+    invalidateOrder(list);
+
+    int oldSize = list->size;
+    memcpy(list->elements + list->head + oldSize, elems, count * sizeof(ListElem));
+
+    // Deleted slots may still fill the index before every element is in
+    for (int i = 0; i < count; i++) {
+        if (!ensureIndexCapacity(list)) {
+            list->size = oldSize;
+            indexRefill(list);
+            return LIST_NO_MEMORY;
+        }
+
+        indexInsert(list, list->head + list->size++);
+    }
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Retrieves a copy of the ID index of the list, with ranks instead of slots.
+ * @param list Pointer to the list.
+ * @param ptSlots Pointer to store the entries (to be freed by the caller).
+ * @param ptSlotCount Pointer to store the number of entries.
+ * @return LIST_OK if successful, LIST_NULL if an argument is NULL, LIST_NO_MEMORY if memory allocation fails.
+ */
+int listIdIndex(PtList list, int **ptSlots, int *ptSlotCount) {
+	if (list == NULL || ptSlots == NULL || ptSlotCount == NULL) return LIST_NULL;
+
+    int *slots = (int*) malloc(list->idSlotCount * sizeof(int));
+    if (slots == NULL) return LIST_NO_MEMORY;
+
+    for (int i = 0; i < list->idSlotCount; i++)
+        slots[i] = list->idSlots[i] >= 0 ? list->idSlots[i] - list->head : list->idSlots[i];
+
+    *ptSlots = slots;
+    *ptSlotCount = list->idSlotCount;
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Checks that saved ID index entries can index a number of elements.
+ * 
+ * The table must have a valid size and load, and hold every rank exactly
+ * once. The hashes of the IDs are not checked: the snapshot that holds the
+ * entries is versioned and checksummed.
+ * 
+ * @param slots The entries.
+ * @param slotCount Number of entries.
+ * @param count Number of elements.
+ * @return True if the entries fit, false otherwise.
+ */
+static bool indexFits(const int *slots, int slotCount, int count) {
+    if (slotCount < INITIAL_ID_SLOTS || (slotCount & (slotCount - 1)) != 0) return false;
+
+    bool *seen = calloc(count > 0 ? count : 1, sizeof(bool));
+    if (seen == NULL) return false;
+
+    int used = 0, ranks = 0;
+    bool fits = true;
+    for (int i = 0; i < slotCount && fits; i++) {
+        if (slots[i] == EMPTY_SLOT) continue;
+        used++;
+        if (slots[i] == DELETED_SLOT) continue;
+
+        fits = slots[i] >= 0 && slots[i] < count && !seen[slots[i]];
+        if (fits) seen[slots[i]] = true;
+        ranks++;
+    }
+
+    free(seen);
+
+    return fits && ranks == count && used * 4 <= slotCount * 3;
+}
+
+/**
+ * @brief Fills an empty list with elements and the ID index saved with them.
+ * @param list Pointer to the list.
+ * @param elems The elements to be appended.
+ * @param count Number of elements.
+ * @param slots Entries of the ID index, as returned by listIdIndex.
+ * @param slotCount Number of entries.
+ * @return LIST_OK if successful, LIST_NULL if an argument is NULL, or LIST_NO_MEMORY if memory allocation fails.
+ */
+int listAppendNIndexed(PtList list, const ListElem *elems, int count, const int *slots, int slotCount) {
+	if (list == NULL || elems == NULL || slots == NULL) return LIST_NULL;
+    if (list->size > 0 || count <= 0 || !indexFits(slots, slotCount, count)) return listAppendN(list, elems, count);
+
+    int *idSlots = (int*) malloc(slotCount * sizeof(int));
+    if (idSlots == NULL || !reserveSlots(list, 0, count)) {
+        free(idSlots);
+        return LIST_NO_MEMORY;
+    }
+
+    invalidateOrder(list);
+
+    memcpy(list->elements + list->head, elems, count * sizeof(ListElem));
+    list->size = count;
+
+    int used = 0;
+    for (int i = 0; i < slotCount; i++) {
+        idSlots[i] = slots[i] >= 0 ? list->head + slots[i] : slots[i];
+        if (slots[i] != EMPTY_SLOT) used++;
+    }
+
+    free(list->idSlots);
+    list->idSlots = idSlots;
+    list->idSlotCount = slotCount;
+    list->idUsedSlots = used;
+
     return LIST_OK;
 }
 
@@ -117,13 +603,22 @@ int listRemove(PtList list, int rank, ListElem *ptElem) {
     ListImpl *lst = (ListImpl *)list;
     if (rank < 0 || rank >= lst->size) return LIST_INVALID_RANK;
 
-    if(ptElem != NULL) *ptElem = lst->elements[rank];
+    if(ptElem != NULL) *ptElem = lst->elements[lst->head + rank];
 
-    // Shift elements
-    for (int i = rank; i < lst->size - 1; i++)
-        lst->elements[i] = lst->elements[i + 1];
+    indexRemove(lst, lst->head + rank);
+    invalidateOrder(lst);
+
+    // Close the gap by moving whichever side of 'rank' has fewer elements
+    bool indexed;
+    if (rank < lst->size - rank - 1) {
+        indexed = moveElements(lst, lst->head + 1, lst->head, rank);
+        lst->head++;
+    }
+    else indexed = moveElements(lst, lst->head + rank, lst->head + rank + 1, lst->size - rank - 1);
 		
     lst->size--;
+
+    if (!indexed) indexRefill(lst);
     return LIST_OK;
 }
 
@@ -142,18 +637,57 @@ int listGet(PtList list, int rank, ListElem *ptElem) {
 
     if(ptElem == NULL) ptElem = (ListElem*) malloc(sizeof(ListElem));
     
-    *ptElem = lst->elements[rank];
+    *ptElem = lst->elements[lst->head + rank];
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Retrieves a read-only pointer to an element of the list at the specified rank.
+ * @param list Pointer to the list.
+ * @param rank The position of the element.
+ * @return Pointer to the element, or NULL if the list is NULL or rank is out of bounds.
+ */
+const ListElem* listGetRef(PtList list, int rank) {
+	if (list == NULL || rank < 0 || rank >= list->size) return NULL;
+
+    return &list->elements[list->head + rank];
+}
+
+/**
+ * @brief Positions an iterator before the first element of the list.
+ * @param list Pointer to the list.
+ * @param it The iterator to initialize.
+ * @return LIST_OK if successful, LIST_NULL if the list or the iterator is NULL.
+ */
+int listIterator(PtList list, ListIterator *it) {
+	if (list == NULL || it == NULL) return LIST_NULL;
+
+    it->next = list->elements + list->head;
+    it->end = it->next + list->size;
 
     return LIST_OK;
 }
 
+/**
+ * @brief Advances an iterator to the next element.
+ * @param it The iterator.
+ * @return Pointer to the next element, or NULL after the last one.
+ */
+const ListElem* listIteratorNext(ListIterator *it) {
+    if (it == NULL || it->next == it->end) return NULL;
+
+    return it->next++;
+}
+
 /**
  * @brief Replaces an element in the list at the specified rank.
  * @param list Pointer to the list.
  * @param rank The position at which to replace the element.
  * @param elem The new element to be placed.
  * @param ptOldElem Pointer to store the old element being replaced.
- * @return LIST_OK if successful, LIST_NULL if the list is NULL, LIST_INVALID_RANK if rank is out of bounds.
+ * @return LIST_OK if successful, LIST_NULL if the list is NULL, LIST_INVALID_RANK if rank is out of bounds,
+ * LIST_NO_MEMORY if the ID index could not grow.
  */
 int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem) {
 	if (list == NULL) return LIST_NULL;
@@ -161,10 +695,22 @@ int listSet(PtList list, int rank, ListElem elem, ListElem *ptOldElem) {
     ListImpl *lst = (ListImpl *)list;
     if (rank < 0 || rank >= lst->size) return LIST_INVALID_RANK;
 
+    int slot = lst->head + rank;
+    bool sameId = strcmp(lst->elements[slot].athleteID, elem.athleteID) == 0;
+
+    // Removing leaves a deleted slot behind, so a new ID needs room like any insertion
+    if (!sameId && !ensureIndexCapacity(lst)) return LIST_NO_MEMORY;
+
     // This may be null if we don't want to keep the old element
-    if(ptOldElem != NULL) *ptOldElem = lst->elements[rank];
+    if(ptOldElem != NULL) *ptOldElem = lst->elements[slot];
 
-    lst->elements[rank] = elem;
+    if (sameId) lst->elements[slot] = elem;
+    else {
+        indexRemove(lst, slot);
+        lst->elements[slot] = elem;
+        indexInsert(lst, slot);
+    }
+    invalidateOrder(lst);
 
     return LIST_OK;
 }
@@ -204,30 +750,190 @@ int listClear(PtList list) {
 	if (list == NULL) return LIST_NULL;
     ListImpl *lst = (ListImpl *)list;
 
-    free(lst->elements);
-
+    // Keep the allocated capacity, the list remains usable
+    lst->head = 0;
     lst->size = 0;
+    invalidateOrder(lst);
+
+    for (int i = 0; i < lst->idSlotCount; i++) lst->idSlots[i] = EMPTY_SLOT;
+    lst->idUsedSlots = 0;
 	
     return LIST_OK;
 }
 
+/**
+ * @brief Finds the rank of an athlete by its ID, using the ID index.
+ * @param list Pointer to the list.
+ * @param athleteID ID of the athlete to find.
+ * @param ptRank Pointer to store the rank of the athlete.
+ * @return LIST_OK if found, LIST_NULL if the list is NULL, LIST_UNKNOWN_ID if no athlete has that ID.
+ */
+int listFindById(PtList list, const char *athleteID, int *ptRank) {
+	if (list == NULL || athleteID == NULL) return LIST_NULL;
+
+    int mask = list->idSlotCount - 1;
+    int found = -1;
+
+    // Walk the whole probe chain so duplicated IDs resolve to the lowest rank
+    for (int i = hashString(athleteID) & mask; list->idSlots[i] != EMPTY_SLOT; i = (i + 1) & mask) {
+        int slot = list->idSlots[i];
+        if (slot < 0 || (found >= 0 && slot > found)) continue;
+
+        if (strcmp(list->elements[slot].athleteID, athleteID) == 0) found = slot;
+    }
+
+    if (found < 0) return LIST_UNKNOWN_ID;
+
+    if (ptRank != NULL) *ptRank = found - list->head;
+    return LIST_OK;
+}
+
+/**
+ * @brief Sorts the list in place, keeping the order of athletes that compare equal.
+ * 
+ * The slots of the athletes are sorted first, so the sort only moves ints,
+ * and the resulting permutation is then applied to the athletes in one pass.
+ * 
+ * @param list Pointer to the list.
+ * @param compare Comparison function.
+ * @return LIST_OK if successful, LIST_NULL if the list or the function is NULL, LIST_NO_MEMORY if memory allocation fails.
+ */
+int listSort(PtList list, ListElemComparator compare) {
+	if (list == NULL || compare == NULL) return LIST_NULL;
+    if (list->size < 2) return LIST_OK;
+
+    int *order = (int*) malloc(list->size * sizeof(int));
+    if (order == NULL) return LIST_NO_MEMORY;
+
+    for (int i = 0; i < list->size; i++) order[i] = list->head + i;
+
+    sortSlots(list, compare, order, list->size);
+
+    // Rank r receives the athlete at order[r], moved one cycle of the permutation at a time
+    ListElem *elements = list->elements + list->head;
+    for (int i = 0; i < list->size; i++) order[i] -= list->head;
+
+    for (int start = 0; start < list->size; start++) {
+        if (order[start] == start) continue;
+
+        ListElem first = elements[start];
+        int rank = start;
+        while (order[rank] != start) {
+            int from = order[rank];
+            elements[rank] = elements[from];
+            order[rank] = rank;
+            rank = from;
+        }
+
+        elements[rank] = first;
+        order[rank] = rank;
+    }
+
+    free(order);
+
+    // Athletes changed slots and ranks
+    indexRefill(list);
+    invalidateOrder(list);
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Sorts an array of slots by radix on the keys of their athletes, then
+ * each run of equal keys by comparisons.
+ * @param list Pointer to the list.
+ * @param key Key function.
+ * @param compare Comparison function, for athletes with equal keys.
+ * @param slots Slots to sort, in ascending order.
+ * @param count Number of slots.
+ * @return True if successful, false if memory allocation fails.
+ */
+static bool sortSlotsByKey(PtList list, ListElemKey key, ListElemComparator compare, int *slots, int count) {
+    const uint64_t **keys = malloc((count > 0 ? count : 1) * sizeof(const uint64_t*));
+    if (keys == NULL) return false;
+
+    for (int i = 0; i < count; i++) keys[i] = key(&list->elements[slots[i]]);
+
+    if (!sortKeyWords(keys, LIST_ELEM_KEY_WORDS, slots, count)) {
+        free(keys);
+        return false;
+    }
+
+    // A key may only hold a prefix of what is compared, so equal keys are not necessarily equal athletes
+    for (int start = 0, end; start < count; start = end) {
+        for (end = start + 1; end < count; end++) {
+            if (memcmp(keys[end], keys[start], LIST_ELEM_KEY_WORDS * sizeof(uint64_t)) != 0) break;
+        }
+
+        if (end - start > 1) sortSlots(list, compare, slots + start, end - start);
+    }
+
+    free(keys);
+
+    return true;
+}
+
+/**
+ * @brief Retrieves the ranks of the list in sorted order, without moving any athlete.
+ * 
+ * The order is sorted on the first call and cached until the list changes or
+ * another key or comparison function is requested.
+ * 
+ * @param list Pointer to the list.
+ * @param key Key function, or NULL to sort by comparisons only.
+ * @param compare Comparison function.
+ * @param ptOrder Pointer to store the ranks (one per athlete), owned by the list.
+ * @return LIST_OK if successful, LIST_NULL if the list, the function or ptOrder is NULL, LIST_NO_MEMORY if memory allocation fails.
+ */
+int listSortedOrder(PtList list, ListElemKey key, ListElemComparator compare, const int **ptOrder) {
+	if (list == NULL || compare == NULL || ptOrder == NULL) return LIST_NULL;
+
+    if (list->order == NULL || list->orderKey != key || list->orderCompare != compare) {
+        int *order = (int*) malloc((list->size > 0 ? list->size : 1) * sizeof(int));
+        if (order == NULL) return LIST_NO_MEMORY;
+
+        for (int i = 0; i < list->size; i++) order[i] = list->head + i;
+
+        if (key == NULL) sortSlots(list, compare, order, list->size);
+        else if (!sortSlotsByKey(list, key, compare, order, list->size)) {
+            free(order);
+            return LIST_NO_MEMORY;
+        }
+
+        for (int i = 0; i < list->size; i++) order[i] -= list->head;
+
+        free(list->order);
+        list->order = order;
+        list->orderKey = key;
+        list->orderCompare = compare;
+    }
+
+    *ptOrder = list->order;
+
+    return LIST_OK;
+}
+
 /**
  * @brief Prints all elements in the list.
  * @param list Pointer to the list.
  */
 void listPrint(PtList list) {
-	if (list == NULL) printf("(List NULL)\n");
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
+	if (list == NULL) outputPrintf(&out, "(List NULL)\n");
     else if (listIsEmpty(list)) 
-		printf("(List EMPTY)\n");
+		outputPrintf(&out, "(List EMPTY)\n");
 	else {        
-        printf("Athletes List (by rank): \n");
+        outputPrintf(&out, "Athletes List (by rank): \n");
 
         ListImpl *lst = (ListImpl *)list;
         for(int i = 0; i < lst->size; i++) {
-            printAthlete(lst->elements[i]);
-            printf("\n");
+            formatAthlete(&out, &lst->elements[lst->head + i]);
+            outputPrintf(&out, "\n");
         }
     }
 
-    printf("\n");
+    outputPrintf(&out, "\n");
+    outputFree(&out);
 }
\ No newline at end of file
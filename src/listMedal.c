@@ -4,10 +4,25 @@
  * @brief Provides an implementation of the ADT List with an array list
  * as the underlying data structure for storing medals.
  * 
- * This file contains functions to manage a list of medals using a dynamic array.
+ * This file contains functions to manage a list of medals using dynamic arrays.
  * It includes functionalities such as creating, destroying, adding, removing,
  * and accessing medals in the list.
  * 
+ * Medals are stored by column: every field has its own array indexed by row,
+ * and a Medal is only assembled when a row is read with listMedalGet. Scans
+ * that look at a few fields read them through listMedalColumns and touch
+ * nothing else. Athlete IDs are stored as ordinals into a pool of the
+ * distinct IDs of the list.
+ * 
+ * The columns are double-ended arrays: the rows occupy a contiguous range of
+ * slots with free room on both sides. Adding or removing at either end is
+ * amortized O(1), and in the middle only the shorter side of the list is
+ * moved, with one memmove per column.
+ * 
+ * The list also holds a secondary index from athlete ID to the rows of
+ * that athlete's medals. It is built in one pass over the list, dropped by
+ * any operation that changes the list and rebuilt on the next lookup.
+ * 
  * @author Raul Rohjans
  * @bug No known bugs.
  */
@@ -16,32 +31,203 @@
 #include "medal.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define INITIAL_CAPACITY 20
 
 typedef struct listImpl {
-	Medal *elements;
+    // One array per field of Medal, all indexed by row
+    int *discipline;
+    int *game;
+    int *eventTitle;
+    int *gender;
+    char *medalType;
+    char *participantType;
+    int *athlete;            ///< Ordinal of the athlete ID in 'athleteIds'.
+    int *country;
+    int *hostIndex;
+    PtStringPool athleteIds; ///< Distinct athlete IDs ever stored in the list, by ordinal.
+    int head;                ///< Slot of the first row, rows occupy slots [head, head + size).
     int size;
-    int capacity;
+    int capacity;            ///< Number of slots of every column.
+
+    // Athlete index: the rows of each athlete are stored contiguously in
+    // 'athleteRows', the athlete with ordinal 'a' owning [groupStart[a], groupStart[a + 1])
+    bool athleteIndexValid;  ///< False until built and after any change to the list.
+    int *athleteRows;        ///< Rows grouped by athlete, in list order within each athlete.
+    int *groupStart;         ///< Start of each athlete in 'athleteRows' (groupCount + 1 entries).
+    int groupCount;          ///< Number of athlete ordinals covered by the index.
 } ListImpl;
 
 /**
- * @brief Ensures the list has sufficient capacity to store more medals.
+ * @brief Releases the athlete index and marks it as out of date.
  * @param list Pointer to the list.
- * @return True if capacity is sufficient or successfully expanded, False on memory allocation failure.
  */
-static bool ensureMedalCapacity(PtListMedal list) {
-    if (list->size < list->capacity) return true;
-    
-    int newCapacity = list->capacity * 2;
+static void invalidateAthleteIndex(PtListMedal list) {
+    if (!list->athleteIndexValid) return;
 
-    Medal *newElements = (Medal*) realloc(list->elements, newCapacity * sizeof(Medal));
-    
-    if (newElements == NULL) return false;
+    free(list->athleteRows);
+    free(list->groupStart);
+
+    list->athleteRows = NULL;
+    list->groupStart = NULL;
+    list->groupCount = 0;
+    list->athleteIndexValid = false;
+}
+
+/**
+ * @brief Resizes one column of the list.
+ * @param column Address of the column.
+ * @param capacity New number of entries.
+ * @param elemSize Size of each entry.
+ * @return True if successful, false on memory allocation failure (the column is left unchanged).
+ */
+static bool resizeColumn(void **column, int capacity, size_t elemSize) {
+    void *newColumn = realloc(*column, capacity * elemSize);
+    if (newColumn == NULL) return false;
+
+    *column = newColumn;
+    return true;
+}
+
+/**
+ * @brief Resizes every column of the list.
+ * @param list Pointer to the list.
+ * @param capacity New number of slots.
+ * @return True if successful, false on memory allocation failure.
+ */
+static bool resizeColumns(PtListMedal list, int capacity) {
+    bool ok = resizeColumn((void**)&list->discipline, capacity, sizeof(int))
+        && resizeColumn((void**)&list->game, capacity, sizeof(int))
+        && resizeColumn((void**)&list->eventTitle, capacity, sizeof(int))
+        && resizeColumn((void**)&list->gender, capacity, sizeof(int))
+        && resizeColumn((void**)&list->medalType, capacity, sizeof(char))
+        && resizeColumn((void**)&list->participantType, capacity, sizeof(char))
+        && resizeColumn((void**)&list->athlete, capacity, sizeof(int))
+        && resizeColumn((void**)&list->country, capacity, sizeof(int))
+        && resizeColumn((void**)&list->hostIndex, capacity, sizeof(int));
+
+    // Columns that did grow are simply larger than needed, the capacity only grows when all do
+    if (ok) list->capacity = capacity;
+
+    return ok;
+}
+
+/**
+ * @brief Frees every column of the list.
+ * @param list Pointer to the list.
+ */
+static void freeColumns(PtListMedal list) {
+    free(list->discipline);
+    free(list->game);
+    free(list->eventTitle);
+    free(list->gender);
+    free(list->medalType);
+    free(list->participantType);
+    free(list->athlete);
+    free(list->country);
+    free(list->hostIndex);
+}
+
+/**
+ * @brief Moves rows of the list inside every column (the ranges may overlap).
+ * @param list Pointer to the list.
+ * @param to First destination slot.
+ * @param from First source slot.
+ * @param count Number of rows to move.
+ */
+static void moveRows(PtListMedal list, int to, int from, int count) {
+    if (count <= 0 || to == from) return;
+
+    memmove(list->discipline + to, list->discipline + from, count * sizeof(int));
+    memmove(list->game + to, list->game + from, count * sizeof(int));
+    memmove(list->eventTitle + to, list->eventTitle + from, count * sizeof(int));
+    memmove(list->gender + to, list->gender + from, count * sizeof(int));
+    memmove(list->medalType + to, list->medalType + from, count * sizeof(char));
+    memmove(list->participantType + to, list->participantType + from, count * sizeof(char));
+    memmove(list->athlete + to, list->athlete + from, count * sizeof(int));
+    memmove(list->country + to, list->country + from, count * sizeof(int));
+    memmove(list->hostIndex + to, list->hostIndex + from, count * sizeof(int));
+}
+
+/**
+ * @brief Returns the ordinal of the athlete ID of a medal, adding it to the pool if needed.
+ * @param list Pointer to the list.
+ * @param elem The medal.
+ * @return The ordinal, or STRING_POOL_NO_CODE on memory allocation failure.
+ */
+static int athleteOrdinal(PtListMedal list, const Medal *elem) {
+    char athleteID[MAX_ID_LENGTH];
+    memcpy(athleteID, elem->athleteID, MAX_ID_LENGTH);
+    athleteID[MAX_ID_LENGTH - 1] = '\0';
+
+    return stringPoolIntern(list->athleteIds, athleteID);
+}
+
+/**
+ * @brief Writes a medal into a row of every column.
+ * @param list Pointer to the list.
+ * @param row The row.
+ * @param elem The medal.
+ * @param athlete Ordinal of the athlete ID of the medal.
+ */
+static void storeRow(PtListMedal list, int row, const Medal *elem, int athlete) {
+    int slot = list->head + row;
+
+    list->discipline[slot] = elem->discipline;
+    list->game[slot] = elem->game;
+    list->eventTitle[slot] = elem->eventTitle;
+    list->gender[slot] = elem->gender;
+    list->medalType[slot] = elem->medalType;
+    list->participantType[slot] = elem->participantType;
+    list->athlete[slot] = athlete;
+    list->country[slot] = elem->country;
+    list->hostIndex[slot] = elem->hostIndex;
+}
+
+/**
+ * @brief Assembles the medal at a row from every column.
+ * @param list Pointer to the list.
+ * @param row The row.
+ * @param elem Medal that receives the fields.
+ */
+static void loadRow(PtListMedal list, int row, Medal *elem) {
+    int slot = list->head + row;
+
+    elem->discipline = list->discipline[slot];
+    elem->game = list->game[slot];
+    elem->eventTitle = list->eventTitle[slot];
+    elem->gender = list->gender[slot];
+    elem->medalType = list->medalType[slot];
+    elem->participantType = list->participantType[slot];
+    strcpy(elem->athleteID, stringPoolGet(list->athleteIds, list->athlete[slot]));
+    elem->country = list->country[slot];
+    elem->hostIndex = list->hostIndex[slot];
+}
+
+/**
+ * @brief Ensures there are free slots before the first row and after the last one.
+ * 
+ * An end that is too short grows by at least the size of the list, so
+ * repeated pushes at either end are amortized O(1).
+ * 
+ * @param list Pointer to the list.
+ * @param front Number of free slots needed before the first row.
+ * @param back Number of free slots needed after the last row.
+ * @return True if there is enough room or the columns were expanded, False on memory allocation failure.
+ */
+static bool reserveSlots(PtListMedal list, int front, int back) {
+    int frontRoom = list->head;
+    int backRoom = list->capacity - list->head - list->size;
+    if (frontRoom >= front && backRoom >= back) return true;
+
+    int head = frontRoom >= front ? frontRoom : (front > list->size ? front : list->size);
+    int backSlots = backRoom >= back ? backRoom : (back > list->size ? back : list->size);
+    if (!resizeColumns(list, head + list->size + backSlots)) return false;
+
+    moveRows(list, head, list->head, list->size);
+    list->head = head;
 
-    list->capacity = newCapacity;
-    list->elements = newElements;
-    
     return true;
 }
 
@@ -54,15 +240,19 @@ PtListMedal listMedalCreate() {
 
     if (list == NULL) return NULL;
 
-    list->elements = malloc(INITIAL_CAPACITY * sizeof(Medal));
-    
-	if (list->elements == NULL) {
+    memset(list, 0, sizeof(ListImpl));
+    list->athleteIds = stringPoolCreate();
+
+	if (list->athleteIds == NULL || !resizeColumns(list, INITIAL_CAPACITY)) {
+        freeColumns(list);
+        stringPoolDestroy(&list->athleteIds);
         free(list);
         return NULL;
     }
 
+    list->head = 0;
     list->size = 0;
-    list->capacity = INITIAL_CAPACITY;
+    list->athleteIndexValid = false;
 
     return list;
 }
@@ -75,11 +265,12 @@ PtListMedal listMedalCreate() {
 int listMedalDestroy(PtListMedal *ptList) {
 	if (ptList == NULL || *ptList == NULL) return LIST_NULL;
 
-    ListImpl *list = (ListImpl *)ptList;
+    ListImpl *list = *ptList;
 
-    free(list->elements);
-	// This throws an exception
-	//free(list);
+    invalidateAthleteIndex(list);
+    freeColumns(list);
+    stringPoolDestroy(&list->athleteIds);
+	free(list);
 
     *ptList = NULL;
 
@@ -96,19 +287,88 @@ int listMedalDestroy(PtListMedal *ptList) {
 int listMedalAdd(PtListMedal list, int rank, Medal elem) {
     if (list == NULL) return LIST_NULL;
     if (rank < 0 || rank > ((ListImpl *)list)->size) return LIST_INVALID_RANK;
-    if (!ensureMedalCapacity(list)) return LIST_NO_MEMORY;
 
     ListImpl *medalList = (ListImpl *)list;
-    // Make space for the new element
-    for (int i = list->size; i > rank; i--)
-        medalList->elements[i] = medalList->elements[i - 1];
-    
-    medalList->elements[rank] = elem;
+
+    // Make space by moving whichever side of 'rank' has fewer rows
+    bool shiftFront = rank < medalList->size - rank;
+    if (!reserveSlots(medalList, shiftFront ? 1 : 0, shiftFront ? 0 : 1)) return LIST_NO_MEMORY;
+
+    int athlete = athleteOrdinal(medalList, &elem);
+    if (athlete == STRING_POOL_NO_CODE) return LIST_NO_MEMORY;
+
+    invalidateAthleteIndex(medalList);
+
+    if (shiftFront) {
+        moveRows(medalList, medalList->head - 1, medalList->head, rank);
+        medalList->head--;
+    }
+    else moveRows(medalList, medalList->head + rank + 1, medalList->head + rank, medalList->size - rank);
+
+    storeRow(medalList, rank, &elem, athlete);
     medalList->size++;
 
     return LIST_OK;
 }
 
+/**
+ * @brief Reserves room in every column for a number of medals.
+ * @param list Pointer to the list.
+ * @param capacity Number of medals to reserve room for.
+ * @return LIST_OK if successful, LIST_NULL if the list is NULL, or LIST_NO_MEMORY if memory allocation fails.
+ */
+int listMedalReserve(PtListMedal list, int capacity) {
+    if (list == NULL) return LIST_NULL;
+
+    return reserveSlots(list, 0, capacity - list->size) ? LIST_OK : LIST_NO_MEMORY;
+}
+
+/**
+ * @brief Adds a medal at the end of the list.
+ * @param list Pointer to the list.
+ * @param elem The medal to be appended.
+ * @return LIST_OK if successful, LIST_NULL if the list is NULL, or LIST_NO_MEMORY if memory allocation fails.
+ */
+int listMedalAppend(PtListMedal list, Medal elem) {
+    if (list == NULL) return LIST_NULL;
+    if (!reserveSlots(list, 0, 1)) return LIST_NO_MEMORY;
+
+    int athlete = athleteOrdinal(list, &elem);
+    if (athlete == STRING_POOL_NO_CODE) return LIST_NO_MEMORY;
+
+    invalidateAthleteIndex(list);
+
+    storeRow(list, list->size++, &elem, athlete);
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Adds an array of medals at the end of the list, in order.
+ * @param list Pointer to the list.
+ * @param elems The medals to be appended.
+ * @param count Number of medals.
+ * @return LIST_OK if successful, LIST_NULL if the list or the medals are NULL, or LIST_NO_MEMORY if memory allocation fails.
+ */
+int listMedalAppendN(PtListMedal list, const Medal *elems, int count) {
+    if (list == NULL || elems == NULL) return LIST_NULL;
+    if (count <= 0) return LIST_OK;
+    if (listMedalReserve(list, list->size + count) != LIST_OK) return LIST_NO_MEMORY;
+
+    // Rows past 'size' are only committed once every athlete ID is interned
+    for (int i = 0; i < count; i++) {
+        int athlete = athleteOrdinal(list, &elems[i]);
+        if (athlete == STRING_POOL_NO_CODE) return LIST_NO_MEMORY;
+
+        storeRow(list, list->size + i, &elems[i], athlete);
+    }
+
+    invalidateAthleteIndex(list);
+    list->size += count;
+
+    return LIST_OK;
+}
+
 /**
  * @brief Removes a medal from the list at the specified rank.
  * @param list Pointer to the list.
@@ -122,11 +382,16 @@ int listMedalRemove(PtListMedal list, int rank, Medal *ptElem) {
     ListImpl *lst = (ListImpl *)list;
     if (rank < 0 || rank >= lst->size) return LIST_INVALID_RANK;
 
-    if(ptElem != NULL) *ptElem = lst->elements[rank];
+    if(ptElem != NULL) loadRow(lst, rank, ptElem);
 
-    // Shift elements
-    for (int i = rank; i < lst->size - 1; i++)
-        lst->elements[i] = lst->elements[i + 1];
+    invalidateAthleteIndex(lst);
+
+    // Close the gap by moving whichever side of 'rank' has fewer rows
+    if (rank < lst->size - rank - 1) {
+        moveRows(lst, lst->head + 1, lst->head, rank);
+        lst->head++;
+    }
+    else moveRows(lst, lst->head + rank, lst->head + rank + 1, lst->size - rank - 1);
 		
     lst->size--;
     return LIST_OK;
@@ -147,7 +412,7 @@ int listMedalGet(PtListMedal list, int rank, Medal *ptElem) {
 
     if(ptElem == NULL) ptElem = (Medal*) malloc(sizeof(Medal));
     
-    *ptElem = lst->elements[rank];
+    loadRow(lst, rank, ptElem);
 
     return LIST_OK;
 }
@@ -166,9 +431,14 @@ int listMedalSet(PtListMedal list, int rank, Medal elem, Medal *ptOldElem) {
     ListImpl *lst = (ListImpl *)list;
     if (rank < 0 || rank >= lst->size) return LIST_INVALID_RANK;
 
-    if(ptOldElem != NULL) *ptOldElem = lst->elements[rank];
+    int athlete = athleteOrdinal(lst, &elem);
+    if (athlete == STRING_POOL_NO_CODE) return LIST_NO_MEMORY;
+
+    if(ptOldElem != NULL) loadRow(lst, rank, ptOldElem);
 
-    lst->elements[rank] = elem;
+    // The athlete index only depends on the athlete IDs
+    if (lst->athlete[lst->head + rank] != athlete) invalidateAthleteIndex(lst);
+    storeRow(lst, rank, &elem, athlete);
 
     return LIST_OK;
 }
@@ -208,30 +478,232 @@ int listMedalClear(PtListMedal list) {
 	if (list == NULL) return LIST_NULL;
     ListImpl *lst = (ListImpl *)list;
 
-    free(lst->elements);
-
+    // Keep the allocated capacity, the list remains usable
+    invalidateAthleteIndex(lst);
+    lst->head = 0;
     lst->size = 0;
 	
     return LIST_OK;
 }
 
+/**
+ * @brief Builds the index from athlete ID to the rows of that athlete's medals.
+ * @param list Pointer to the list.
+ * @return LIST_OK if successful, LIST_NULL if the list is NULL, LIST_NO_MEMORY if memory allocation fails.
+ */
+int listMedalIndexAthletes(PtListMedal list) {
+    if (list == NULL) return LIST_NULL;
+    if (list->athleteIndexValid) return LIST_OK;
+
+    // Athletes are already numbered by their ordinal, a counting sort groups the rows
+    int groupCount = stringPoolSize(list->athleteIds);
+    int *counts = calloc(groupCount + 1, sizeof(int));
+    int *next = malloc((groupCount > 0 ? groupCount : 1) * sizeof(int));
+    int *rows = malloc((list->size > 0 ? list->size : 1) * sizeof(int));
+
+    if (counts == NULL || next == NULL || rows == NULL) {
+        free(counts);
+        free(next);
+        free(rows);
+        return LIST_NO_MEMORY;
+    }
+
+    const int *athlete = list->athlete + list->head;
+    for (int row = 0; row < list->size; row++) counts[athlete[row]]++;
+
+    // Turn the counts into start offsets
+    int offset = 0;
+    for (int a = 0; a < groupCount; a++) {
+        int count = counts[a];
+        counts[a] = offset;
+        next[a] = offset;
+        offset += count;
+    }
+    counts[groupCount] = offset;
+
+    // Place the rows, in list order within each athlete
+    for (int row = 0; row < list->size; row++) rows[next[athlete[row]]++] = row;
+
+    free(next);
+
+    list->athleteRows = rows;
+    list->groupStart = counts;
+    list->groupCount = groupCount;
+    list->athleteIndexValid = true;
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Retrieves the rows of the medals won by an athlete.
+ * @param list Pointer to the list.
+ * @param athleteID ID of the athlete.
+ * @param ptRows Pointer to store the rows, valid until the list changes.
+ * @param ptCount Pointer to store the number of rows.
+ * @return LIST_OK if successful, LIST_NULL if an argument is NULL, LIST_NO_MEMORY if the index could not be built.
+ */
+int listMedalRowsOfAthlete(PtListMedal list, const char *athleteID, const int **ptRows, int *ptCount) {
+    if (list == NULL || athleteID == NULL || ptRows == NULL || ptCount == NULL) return LIST_NULL;
+
+    int error = listMedalIndexAthletes(list);
+    if (error != LIST_OK) return error;
+
+    *ptRows = NULL;
+    *ptCount = 0;
+
+    // IDs of removed medals keep their ordinal, they just own no rows
+    int athlete = stringPoolFind(list->athleteIds, athleteID);
+    if (athlete == STRING_POOL_NO_CODE) return LIST_OK;
+
+    int start = list->groupStart[athlete];
+    int count = list->groupStart[athlete + 1] - start;
+    if (count > 0) {
+        *ptRows = list->athleteRows + start;
+        *ptCount = count;
+    }
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Retrieves the whole athlete index of the list.
+ * @param list Pointer to the list.
+ * @param ptRows Pointer to store the rows grouped by athlete.
+ * @param ptGroupStart Pointer to store the start of each athlete in the rows.
+ * @param ptGroupCount Pointer to store the number of athlete ordinals.
+ * @return LIST_OK if successful, LIST_NULL if an argument is NULL, LIST_NO_MEMORY if the index could not be built.
+ */
+int listMedalAthleteIndex(PtListMedal list, const int **ptRows, const int **ptGroupStart, int *ptGroupCount) {
+    if (list == NULL || ptRows == NULL || ptGroupStart == NULL || ptGroupCount == NULL) return LIST_NULL;
+
+    int error = listMedalIndexAthletes(list);
+    if (error != LIST_OK) return error;
+
+    *ptRows = list->athleteRows;
+    *ptGroupStart = list->groupStart;
+    *ptGroupCount = list->groupCount;
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Checks that a saved athlete index matches the rows of the list.
+ * @param list Pointer to the list.
+ * @param rows Rows grouped by athlete.
+ * @param groupStart Start of each athlete in 'rows'.
+ * @param groupCount Number of athlete ordinals.
+ * @return True if every row is listed once, under the ordinal of its athlete, in ascending order.
+ */
+static bool athleteIndexMatches(PtListMedal list, const int *rows, const int *groupStart, int groupCount) {
+    if (groupCount != stringPoolSize(list->athleteIds) || groupStart[0] != 0 || groupStart[groupCount] != list->size)
+        return false;
+
+    const int *athlete = list->athlete + list->head;
+    for (int a = 0; a < groupCount; a++) {
+        if (groupStart[a + 1] < groupStart[a]) return false;
+
+        for (int i = groupStart[a]; i < groupStart[a + 1]; i++) {
+            if (rows[i] < 0 || rows[i] >= list->size || athlete[rows[i]] != a) return false;
+            if (i > groupStart[a] && rows[i] <= rows[i - 1]) return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Sets the athlete index of the list from a saved copy, or builds it if the copy does not match.
+ * @param list Pointer to the list.
+ * @param rows Rows grouped by athlete.
+ * @param groupStart Start of each athlete in 'rows' (groupCount + 1 entries).
+ * @param groupCount Number of athlete ordinals.
+ * @return LIST_OK if successful, LIST_NULL if an argument is NULL, LIST_NO_MEMORY if memory allocation fails.
+ */
+int listMedalSetAthleteIndex(PtListMedal list, const int *rows, const int *groupStart, int groupCount) {
+    if (list == NULL || rows == NULL || groupStart == NULL) return LIST_NULL;
+
+    invalidateAthleteIndex(list);
+    if (groupCount < 0 || !athleteIndexMatches(list, rows, groupStart, groupCount)) return listMedalIndexAthletes(list);
+
+    int *athleteRows = malloc((list->size > 0 ? list->size : 1) * sizeof(int));
+    int *starts = malloc((groupCount + 1) * sizeof(int));
+
+    if (athleteRows == NULL || starts == NULL) {
+        free(athleteRows);
+        free(starts);
+        return LIST_NO_MEMORY;
+    }
+
+    memcpy(athleteRows, rows, list->size * sizeof(int));
+    memcpy(starts, groupStart, (groupCount + 1) * sizeof(int));
+
+    list->athleteRows = athleteRows;
+    list->groupStart = starts;
+    list->groupCount = groupCount;
+    list->athleteIndexValid = true;
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Retrieves read-only views of the columns of the list.
+ * @param list Pointer to the list.
+ * @param columns Structure that receives the columns, valid until the list changes.
+ * @return LIST_OK if successful, LIST_NULL if an argument is NULL.
+ */
+int listMedalColumns(PtListMedal list, MedalColumns *columns) {
+    if (list == NULL || columns == NULL) return LIST_NULL;
+
+    columns->size = list->size;
+    columns->discipline = list->discipline + list->head;
+    columns->game = list->game + list->head;
+    columns->eventTitle = list->eventTitle + list->head;
+    columns->gender = list->gender + list->head;
+    columns->medalType = list->medalType + list->head;
+    columns->participantType = list->participantType + list->head;
+    columns->athlete = list->athlete + list->head;
+    columns->country = list->country + list->head;
+    columns->hostIndex = list->hostIndex + list->head;
+    columns->athleteCount = stringPoolSize(list->athleteIds);
+
+    return LIST_OK;
+}
+
+/**
+ * @brief Returns the athlete ID with a given ordinal in the list.
+ * @param list Pointer to the list.
+ * @param athlete Ordinal of the athlete (see MedalColumns.athlete).
+ * @return The athlete ID, or NULL if the list is NULL or the ordinal is not valid.
+ */
+const char* listMedalAthleteId(PtListMedal list, int athlete) {
+    if (list == NULL) return NULL;
+
+    return stringPoolGet(list->athleteIds, athlete);
+}
+
 /**
  * @brief Prints all medals in the list.
  * @param list Pointer to the list.
  */
 void listMedalPrint(PtListMedal list) {
-	if (list == NULL) printf("(List NULL)\n");
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
+	if (list == NULL) outputPrintf(&out, "(List NULL)\n");
     else if (listMedalIsEmpty(list)) 
-		printf("(List EMPTY)\n");
+		outputPrintf(&out, "(List EMPTY)\n");
 	else {        
-        printf("Medals List (by rank): \n");
+        outputPrintf(&out, "Medals List (by rank): \n");
 
         ListImpl *lst = (ListImpl *)list;
         for(int i = 0; i < lst->size; i++) {
-            printMedal((Medal)lst->elements[i]);
-            printf("\n");
+            Medal medal;
+            loadRow(lst, i, &medal);
+            formatMedal(&out, &medal);
+            outputPrintf(&out, "\n");
         }
     }
 
-    printf("\n");
+    outputPrintf(&out, "\n");
+    outputFree(&out);
 }
\ No newline at end of file
@@ -23,6 +23,23 @@ int main() {
     PtMap hosts = NULL;
     /* ----------------- */
 
+    // Threads used to parse large files, e.g., OLYMPICS_IMPORT_THREADS=8 ./bin/prog
+    const char *importThreads = getenv(IMPORT_THREADS_VARIABLE);
+    if(importThreads != NULL) setImportThreadCount(atoi(importThreads));
+
+    // Restore what was loaded in a previous session, if the CSV files did not change
+    if(importFromSnapshots(&athletes, &medals, &hosts)) {
+        int athleteLoadSize = 0, medalLoadSize = 0, hostLoadSize = 0;
+        if(athletes != NULL) listSize(athletes, &athleteLoadSize);
+        if(medals != NULL) listMedalSize(medals, &medalLoadSize);
+        if(hosts != NULL) mapSize(hosts, &hostLoadSize);
+
+        printf("Restored from snapshot Athletes (%d) | Medals (%d) | Hosts (%d)\n", athleteLoadSize, medalLoadSize, hostLoadSize);
+
+        // Host indexes saved in the snapshot may refer to other hosts
+        linkMedalHosts(medals, hosts);
+    }
+
 
     while(true) { // Start main menu
         switch(startMenu()) {
@@ -49,6 +66,9 @@ int main() {
 
                     // Means they were not loaded properly
                     if(medals == NULL) medals = listMedalCreate();
+
+                    // Resolve the host of every medal, if hosts are loaded
+                    linkMedalHosts(medals, hosts);
                     
                     break;
                 }
@@ -62,6 +82,9 @@ int main() {
 
                     // Means they were not loaded properly
                     if(hosts == NULL) hosts = mapCreate();
+
+                    // Medals loaded before must point to the new hosts
+                    linkMedalHosts(medals, hosts);
                     
                     break;
                 }
@@ -87,17 +110,17 @@ int main() {
                 {
                     if(!validateAthletes(athletes)) break;
 
-                    PtList athleteCopy = listAthleteShallowCopy(athletes);
-                    orderAthletesAlphabetic(&athleteCopy);
-                    if(athleteCopy == NULL) {
+                    // Sorted once, then reused until the athletes are reloaded
+                    const int *order = orderAthletesAlphabetic(athletes);
+                    if(order == NULL) {
                         printf("Could not sort athletes, the resulting list is empty.");
-                        free(athleteCopy);
                         return EXIT_FAILURE;
                     }
 
-                    paginate(athleteCopy);
+                    AthleteCursor cursor;
+                    athleteCursorOpen(&cursor, athletes, order, NULL, 0, MAX_PAGE_SIZE);
 
-                    free(athleteCopy);
+                    paginate(&cursor);
                 }
                 break;
             case 6: // SHOW_PARTICIPATIONS
@@ -117,26 +140,19 @@ int main() {
                         return EXIT_FAILURE;
                     }
 
-                    // Filter per participation
-                    PtList filteredAthletes = filterAthletesPerParticipation(athletes, participations);
-                    
-                    // Order by name
-                    orderAthletesAlphabetic(&filteredAthletes);
-
-                    if(filteredAthletes == NULL) {
+                    // Filter per participation, in name order, a page at a time
+                    const int *order = orderAthletesAlphabetic(athletes);
+                    if(order == NULL) {
                         printf("Could not filter athletes, the resulting list is empty.");
-                        free(filteredAthletes);
                         return EXIT_FAILURE;
                     }
 
-                    // Validate size
-                    int size = 0;
-                    listSize(filteredAthletes, &size);
-
-                    if(size < 1) printf("No athletes found with at least %d participations", participations);
-                    else paginate(filteredAthletes);
+                    AthleteCursor cursor;
+                    athleteCursorOpen(&cursor, athletes, order, filterAthletesPerParticipation, participations, MAX_PAGE_SIZE);
 
-                    free(filteredAthletes);
+                    // Validate size
+                    if(cursor.count < 1) printf("No athletes found with at least %d participations", participations);
+                    else paginate(&cursor);
                 }
                 break;
             case 7: // SHOW_FIRST
@@ -156,26 +172,19 @@ int main() {
                         return EXIT_FAILURE;
                     }
 
-                    // Filter per participation
-                    PtList filteredAthletes = filterAthletesPerFirstYear(athletes, year);
-
-                    // Order by name
-                    orderAthletesAlphabetic(&filteredAthletes);
-
-                    if(filteredAthletes == NULL) {
+                    // Filter per first participation, in name order, a page at a time
+                    const int *order = orderAthletesAlphabetic(athletes);
+                    if(order == NULL) {
                         printf("Could not filter athletes, the resulting list is empty.");
-                        free(filteredAthletes);
                         return EXIT_FAILURE;
                     }
 
-                    // Validate size
-                    int size = 0;
-                    listSize(filteredAthletes, &size);
-
-                    if(size < 1) printf("No athletes whose first participation was at %d", year);
-                    else paginate(filteredAthletes);
+                    AthleteCursor cursor;
+                    athleteCursorOpen(&cursor, athletes, order, filterAthletesPerFirstYear, year, MAX_PAGE_SIZE);
 
-                    free(filteredAthletes);
+                    // Validate size
+                    if(cursor.count < 1) printf("No athletes whose first participation was at %d", year);
+                    else paginate(&cursor);
                 }
                 break;
             case 8: //SHOW_HOST
@@ -187,18 +196,13 @@ int main() {
                     printf("Insert a location -> ");
                     readString(location, MAX_ID_LENGTH);
 
-                    int size = 0;
-                    mapSize(hosts, &size);
+                    MapIterator it;
+                    mapIterator(hosts, &it);
 
                     bool found = false;
-                    MapValue *values = mapValues(hosts);
-                    int i = 0;
-                    for(; i < size; i++) {
-                        if(strcmp(stringToLower(values[i].location), stringToLower(location)) == 0) {
-                            found = true;
-                            break;
-                        }
-                    }
+                    const Host *host = NULL;
+                    while(!found && mapIteratorNext(&it, NULL, &host))
+                        found = compareIgnoreCase(host->location, location) == 0;
 
                     if(!found) {
                         printf("Could not find a host with that slug!\n");
@@ -206,11 +210,10 @@ int main() {
                     }
 
                     clearScreen();
-                    printHost(values[i]);
+                    printHost(*host);
                     printf("\nPress any key to continue.");
                     getchar();
 
-                    free(values);
                     break;
                 }
             case 9: //DISCIPLINE_STATISTICS
@@ -283,6 +286,37 @@ int main() {
 
                     showTopN(athleteCount, startYear, endYear, gameType, athletes, medals, hosts);
                     
+                    break;
+                }
+            case 12: // LOAD_ALL
+                {
+                    PtList newAthletes = NULL;
+                    PtListMedal newMedals = NULL;
+                    PtMap newHosts = NULL;
+
+                    importAll(&newAthletes, &newMedals, &newHosts);
+
+                    // Clear current data
+                    listClear(athletes);
+                    listDestroy(&athletes);
+                    listMedalClear(medals);
+                    listMedalDestroy(&medals);
+                    mapClear(hosts);
+                    mapDestroy(&hosts);
+
+                    // Means they were not loaded properly
+                    athletes = validateAthletes(newAthletes) ? newAthletes : listCreate();
+                    medals = validateMedals(newMedals) ? newMedals : listMedalCreate();
+                    hosts = validateHosts(newHosts) ? newHosts : mapCreate();
+
+                    linkMedalHosts(medals, hosts);
+
+                    int athleteLoadSize, medalLoadSize, hostLoadSize;
+                    listSize(athletes, &athleteLoadSize);
+                    listMedalSize(medals, &medalLoadSize);
+                    mapSize(hosts, &hostLoadSize);
+
+                    printf("Records loaded into Athletes (%d) | Medals (%d) | Hosts (%d)\n", athleteLoadSize, medalLoadSize, hostLoadSize);
                     break;
                 }
             case 0: // QUIT
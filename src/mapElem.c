@@ -3,12 +3,13 @@
  * 
  * @brief Provides utility functions for map element operations.
  * 
- * This file includes essential functions for comparing keys in map data structures,
+ * This file includes essential functions for comparing and hashing keys in map data structures,
  * facilitating key-based operations such as insertions, deletions, and searches.
  * 
  * @author Raul Rohjans
  */
 #include "mapElem.h"
+#include "helpers.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -26,4 +27,16 @@ bool mapKeyEquals(MapKey key1, MapKey key2) {
     int res = strcmp(key1, key2);
 
     return res == 0;
+}
+
+/**
+ * @brief Computes the hash of a map key.
+ * 
+ * Uses the FNV-1a hash of the string (see hashString).
+ * 
+ * @param key The key to hash.
+ * @return The hash of the key.
+ */
+unsigned int mapKeyHash(MapKey key) {
+    return hashString(key);
 }
\ No newline at end of file
@@ -1,12 +1,14 @@
 /**
  * @file mapHost.c
  * 
- * @brief Provides an implementation of the ADT Map with an array list
- * as the underlying data structure for storing hosts.
+ * @brief Provides an implementation of the ADT Map with an open-addressing
+ * hash table as the underlying data structure for storing hosts.
  * 
- * This file contains functions to manage a map of hosts using a dynamic array.
- * It includes functionalities such as creating, destroying, adding, removing,
- * and accessing hosts in the map based on a key.
+ * Key-value pairs are kept in a dense array in insertion order, and a separate
+ * table of slots (linear probing) maps each key hash to its index in that array.
+ * Lookups are amortized O(1), while mapKeys/mapValues keep returning the pairs
+ * in a deterministic order (insertion order, with the last pair moved into the
+ * place of a removed one).
  * 
  * @author Raul Rohjans
  * @bug No known bugs.
@@ -19,34 +21,100 @@
 #include <string.h>
 
 #define INITIAL_CAPACITY 20
+#define INITIAL_SLOTS 64  ///< Must be a power of two.
+
+#define EMPTY_SLOT -1     ///< Slot never used.
+#define DELETED_SLOT -2   ///< Slot whose pair was removed (keeps probe chains intact).
 
 typedef struct keyValue {
 	MapKey key;
 	MapValue value;
+	unsigned int hash;
 } KeyValue;
 
 typedef struct mapImpl {
 	KeyValue *elements;
 	int capacity;
 	int size;
+	int *slots;      ///< Index into 'elements', EMPTY_SLOT or DELETED_SLOT.
+	int slotCount;   ///< Number of slots, always a power of two.
+	int usedSlots;   ///< Slots that are not EMPTY_SLOT.
 } MapImpl;
 
 /**
- * @brief Finds the index of a specific key in the map.
+ * @brief Finds the slot that holds a specific key.
  * 
  * Keys are compared using the mapKeyEquals function.
  * 
  * @param map Pointer to the map.
  * @param key Key to find.
+ * @param hash Hash of 'key'.
+ * @return Slot containing 'key', or -1 if no slot contains 'key'.
+ */
+static int findSlotOfKey(PtMap map, MapKey key, unsigned int hash) {
+	int mask = map->slotCount - 1;
+
+	for (int i = hash & mask; map->slots[i] != EMPTY_SLOT; i = (i + 1) & mask) {
+		int index = map->slots[i];
+
+		if (index >= 0 && map->elements[index].hash == hash &&
+			mapKeyEquals(map->elements[index].key, key)) return i;
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Finds the index of a specific key in the map.
+ * 
+ * @param map Pointer to the map.
+ * @param key Key to find.
  * @return Index of 'elements' containing 'key', or -1 if no index contains 'key'.
  */
 static int findIndexOfKey(PtMap map, MapKey key) {
-	if (map == NULL) return -1;
+	if (map == NULL || map->size == 0) return -1;
 
-	for (int i = 0; i < map->size; i++)
-		if (mapKeyEquals(map->elements[i].key, key)) return i;
+	int slot = findSlotOfKey(map, key, mapKeyHash(key));
 
-	return -1;
+	return slot == -1 ? -1 : map->slots[slot];
+}
+
+/**
+ * @brief Places an element index in the first free slot of its probe chain.
+ * 
+ * @param map Pointer to the map.
+ * @param index Index of the element in 'elements'.
+ */
+static void insertSlot(PtMap map, int index) {
+	int mask = map->slotCount - 1;
+
+	int i = map->elements[index].hash & mask;
+	while (map->slots[i] >= 0) i = (i + 1) & mask;
+
+	if (map->slots[i] == EMPTY_SLOT) map->usedSlots++;
+	map->slots[i] = index;
+}
+
+/**
+ * @brief Rebuilds the slot table with a new number of slots, dropping deleted slots.
+ * 
+ * @param map Pointer to the map.
+ * @param slotCount New number of slots (power of two).
+ * @return True if successful, False on memory allocation failure.
+ */
+static bool rehash(PtMap map, int slotCount) {
+	int *newSlots = (int*) malloc(slotCount * sizeof(int));
+	if (newSlots == NULL) return false;
+
+	free(map->slots);
+	map->slots = newSlots;
+	map->slotCount = slotCount;
+	map->usedSlots = 0;
+
+	for (int i = 0; i < slotCount; i++) map->slots[i] = EMPTY_SLOT;
+	for (int i = 0; i < map->size; i++) insertSlot(map, i);
+
+	return true;
 }
 
 /**
@@ -56,6 +124,14 @@ static int findIndexOfKey(PtMap map, MapKey key) {
  * @return True if the capacity is sufficient or successfully expanded, False on memory allocation failure.
  */
 static bool ensureCapacity(PtMap map) {
+	// Keep the slot table at most 3/4 full, counting deleted slots
+	if ((map->usedSlots + 1) * 4 > map->slotCount * 3) {
+		int slotCount = map->slotCount;
+		while ((map->size + 1) * 2 > slotCount) slotCount *= 2;
+
+		if (!rehash(map, slotCount)) return false;
+	}
+
 	if (map->size == map->capacity) {
 		int newCapacity = map->capacity * 2;
 		KeyValue* newArray = (KeyValue*) realloc( map->elements, 
@@ -85,8 +161,19 @@ PtMap mapCreate() {
 		return NULL;
 	}
 
+	newMap->slots = (int*)malloc(INITIAL_SLOTS * sizeof(int));
+	if (newMap->slots == NULL) {
+		free(newMap->elements);
+		free(newMap);
+		return NULL;
+	}
+
+	for (int i = 0; i < INITIAL_SLOTS; i++) newMap->slots[i] = EMPTY_SLOT;
+
 	newMap->size = 0;
 	newMap->capacity = INITIAL_CAPACITY;
+	newMap->slotCount = INITIAL_SLOTS;
+	newMap->usedSlots = 0;
 
 	return newMap;
 }
@@ -102,7 +189,11 @@ int mapDestroy(PtMap *ptMap) {
 
 	if (map == NULL) return MAP_NULL;
 
+	for (int i = 0; i < map->size; i++)
+		free(map->elements[i].key);
+
 	if(map->elements != NULL) free(map->elements);
+	free(map->slots);
 	free(map);
 
 	*ptMap = NULL;
@@ -113,7 +204,8 @@ int mapDestroy(PtMap *ptMap) {
 /**
  * @brief Adds a key-value pair to the map.
  * 
- * If the key already exists, the value is updated.
+ * If the key already exists, the value is updated. Otherwise the map
+ * stores its own copy of the key, so callers may pass temporary buffers.
  * 
  * @param map Pointer to the map.
  * @param key Key of the element to add.
@@ -123,16 +215,23 @@ int mapDestroy(PtMap *ptMap) {
 int mapPut(PtMap map, MapKey key, MapValue value) {
 	if (map == NULL) return MAP_NULL;
 
-	int index = findIndexOfKey(map, key);
-	if (index != -1) {
-		map->elements[index].value = value;
+	unsigned int hash = mapKeyHash(key);
+
+	int slot = findSlotOfKey(map, key, hash);
+	if (slot != -1) {
+		map->elements[map->slots[slot]].value = value;
 		return MAP_OK;
 	}
 
 	if (!ensureCapacity(map)) return MAP_NO_MEMORY;
 
-	map->elements[map->size].key = key;
+	MapKey keyCopy = strdup(key);
+	if (keyCopy == NULL) return MAP_NO_MEMORY;
+
+	map->elements[map->size].key = keyCopy;
 	map->elements[map->size].value = value;
+	map->elements[map->size].hash = hash;
+	insertSlot(map, map->size);
 	map->size++;
 
 	return MAP_OK;
@@ -150,12 +249,24 @@ int mapRemove(PtMap map, MapKey key, MapValue *ptValue) {
 	if (map == NULL) return MAP_NULL;
 	if (map->size == 0) return MAP_EMPTY;
 
-	int index = findIndexOfKey(map, key);
-	if (index == -1) return MAP_UNKNOWN_KEY;
+	int slot = findSlotOfKey(map, key, mapKeyHash(key));
+	if (slot == -1) return MAP_UNKNOWN_KEY;
+
+	int index = map->slots[slot];
+	int last = map->size - 1;
 
 	*ptValue = map->elements[index].value;
+	free(map->elements[index].key);
+	map->slots[slot] = DELETED_SLOT;
+
+	// Move the last pair into the freed position and repoint its slot
+	if (index != last) {
+		int lastSlot = findSlotOfKey(map, map->elements[last].key, map->elements[last].hash);
+
+		map->elements[index] = map->elements[last];
+		map->slots[lastSlot] = index;
+	}
 
-	map->elements[index] = map->elements[map->size - 1];
 	map->size--;
 	
 	return MAP_OK;
@@ -194,6 +305,105 @@ int mapGet(PtMap map, MapKey key, MapValue *ptValue) {
 	return MAP_OK;
 }
 
+/**
+ * @brief Retrieves the index of a key, i.e., its position in mapKeys/mapValues.
+ * 
+ * @param map Pointer to the map.
+ * @param key Key to find.
+ * @param ptIndex Pointer to store the index.
+ * @return MAP_OK if successful, MAP_NULL if the map is NULL, MAP_EMPTY if the map is empty, or MAP_UNKNOWN_KEY if the key does not exist.
+ */
+int mapIndexOf(PtMap map, MapKey key, int *ptIndex) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+
+	int index = findIndexOfKey(map, key);
+	if (index == -1) return MAP_UNKNOWN_KEY;
+
+	*ptIndex = index;
+
+	return MAP_OK;
+}
+
+/**
+ * @brief Retrieves the value at a given index (see mapIndexOf).
+ * 
+ * @param map Pointer to the map.
+ * @param index Index of the value.
+ * @param ptValue Pointer to store the value.
+ * @return MAP_OK if successful, MAP_NULL if the map is NULL, MAP_EMPTY if the map is empty, or MAP_UNKNOWN_KEY if the index is out of bounds.
+ */
+int mapGetAt(PtMap map, int index, MapValue *ptValue) {
+	if (map == NULL) return MAP_NULL;
+	if (map->size == 0) return MAP_EMPTY;
+	if (index < 0 || index >= map->size) return MAP_UNKNOWN_KEY;
+
+	*ptValue = map->elements[index].value;
+
+	return MAP_OK;
+}
+
+/**
+ * @brief Retrieves a read-only pointer to the value associated with a key.
+ * 
+ * @param map Pointer to the map.
+ * @param key Key for retrieval.
+ * @return Pointer to the value, or NULL if the key doesn't exist or the map is NULL.
+ */
+const MapValue* mapGetRef(PtMap map, MapKey key) {
+	int index = findIndexOfKey(map, key);
+
+	return index == -1 ? NULL : &map->elements[index].value;
+}
+
+/**
+ * @brief Retrieves a read-only pointer to the value at an index of the map.
+ * 
+ * @param map Pointer to the map.
+ * @param index Index of the value.
+ * @return Pointer to the value, or NULL if the index is out of bounds or the map is NULL.
+ */
+const MapValue* mapGetAtRef(PtMap map, int index) {
+	if (map == NULL || index < 0 || index >= map->size) return NULL;
+
+	return &map->elements[index].value;
+}
+
+/**
+ * @brief Positions an iterator before the first pair of the map.
+ * 
+ * @param map Pointer to the map.
+ * @param it The iterator to initialize.
+ * @return MAP_OK if successful, MAP_NULL if the map or the iterator is NULL.
+ */
+int mapIterator(PtMap map, MapIterator *it) {
+	if (map == NULL || it == NULL) return MAP_NULL;
+
+	it->map = map;
+	it->index = 0;
+
+	return MAP_OK;
+}
+
+/**
+ * @brief Advances an iterator to the next pair, in index order.
+ * 
+ * @param it The iterator.
+ * @param ptKey Pointer to store the key, or NULL.
+ * @param ptValue Pointer to store a pointer to the value, or NULL.
+ * @return True if a pair was retrieved, false after the last one.
+ */
+bool mapIteratorNext(MapIterator *it, MapKey *ptKey, const MapValue **ptValue) {
+	if (it == NULL || it->map == NULL || it->index >= it->map->size) return false;
+
+	const KeyValue *pair = &it->map->elements[it->index++];
+
+	if (ptKey != NULL) *ptKey = pair->key;
+	if (ptValue != NULL) *ptValue = &pair->value;
+
+	return true;
+}
+
 /**
  * @brief Returns an array of all keys in the map.
  * 
@@ -264,8 +474,15 @@ bool mapIsEmpty(PtMap map) {
  */
 int mapClear(PtMap map) {
 	if (map == NULL) return MAP_NULL;
+
+	for (int i = 0; i < map->size; i++)
+		free(map->elements[i].key);
+
+	for (int i = 0; i < map->slotCount; i++)
+		map->slots[i] = EMPTY_SLOT;
 	
 	map->size = 0;
+	map->usedSlots = 0;
 
 	return MAP_OK;
 }
@@ -276,19 +493,24 @@ int mapClear(PtMap map) {
  * @param map Pointer to the map.
  */
 void mapPrint(PtMap map) {
+    OutputBuffer out;
+    outputInit(&out, OUTPUT_BUFFER_CAPACITY);
+
 	if (map == NULL)
-		printf("(MAP NULL)\n");	
+		outputPrintf(&out, "(MAP NULL)\n");	
 	else if (mapIsEmpty(map))
-		printf("(MAP EMPTY)\n");
+		outputPrintf(&out, "(MAP EMPTY)\n");
 	else {
-		printf("Key -> Value\n");
-		printf("------------\n");
+		outputPrintf(&out, "Key -> Value\n");
+		outputPrintf(&out, "------------\n");
 
 		for (int i = 0; i < map->size; i++) {
-			printf("%s -> \n", map->elements[i].key);
+			outputPrintf(&out, "%s -> \n", map->elements[i].key);
 
-            printHost(map->elements[i].value);
-			printf("\n\n");
+            formatHost(&out, &map->elements[i].value);
+			outputPrintf(&out, "\n\n");
 		}
 	}
+
+    outputFree(&out);
 }
@@ -14,11 +14,75 @@
 #include <stdlib.h>
 #include <string.h>
 
+static PtStringPool dictionaries[MEDAL_FIELD_COUNT];  ///< Values of each text field, created on first use.
+
+/**
+ * @brief Returns the code of a value of a medal field, adding it to the dictionary if needed.
+ * @param field The field the value belongs to.
+ * @param value The value to intern.
+ * @return The code of the value, or STRING_POOL_NO_CODE if memory allocation fails.
+ */
+int medalIntern(MedalField field, const char *value) {
+    if (dictionaries[field] == NULL) {
+        dictionaries[field] = stringPoolCreate();
+        stringPoolIntern(dictionaries[field], "");  // MEDAL_EMPTY_CODE
+    }
+
+    return stringPoolIntern(dictionaries[field], value);
+}
+
+/**
+ * @brief Returns the code of a value of a medal field without adding it.
+ * @param field The field the value belongs to.
+ * @param value The value to find.
+ * @return The code of the value, or STRING_POOL_NO_CODE if no medal has that value.
+ */
+int medalCode(MedalField field, const char *value) {
+    return stringPoolFind(dictionaries[field], value);
+}
+
+/**
+ * @brief Returns the text of a code of a medal field.
+ * @param field The field the code belongs to.
+ * @param code The code.
+ * @return The text, or an empty string if the code is not valid.
+ */
+const char* medalString(MedalField field, int code) {
+    const char *value = stringPoolGet(dictionaries[field], code);
+
+    return value != NULL ? value : "";
+}
+
+/**
+ * @brief Returns the number of distinct values of a medal field.
+ * @param field The field.
+ * @return Number of values.
+ */
+int medalStringCount(MedalField field) {
+    return stringPoolSize(dictionaries[field]);
+}
+
+/**
+ * @brief Returns the address of the code a medal holds for a text field.
+ * @param medal The medal.
+ * @param field The field.
+ * @return Address of the code inside 'medal'.
+ */
+int* medalFieldCode(Medal *medal, MedalField field) {
+    switch (field) {
+        case MEDAL_DISCIPLINE: return &medal->discipline;
+        case MEDAL_GAME: return &medal->game;
+        case MEDAL_EVENT: return &medal->eventTitle;
+        case MEDAL_GENDER: return &medal->gender;
+        default: return &medal->country;
+    }
+}
+
 /**
  * @brief Creates a new Medal instance and initializes it with the provided details.
  * 
  * Allocates memory for a new Medal and sets its properties based on the provided parameters.
- * The strings are copied safely to avoid buffer overflow.
+ * The text fields are interned and the athlete ID is copied safely to avoid buffer overflow.
  * 
  * @param discipline Name of the discipline for which the medal is awarded.
  * @param event Title of the event the medal is associated with.
@@ -32,13 +96,15 @@
 Medal* createMedal(const char* discipline, const char* event, const char* gender, char medalType, char participantType, const char* athleteId, const char* country) {
     Medal* newMedal = (Medal*) malloc(sizeof(Medal));
     if (newMedal) {
-        strncpy(newMedal->discipline, discipline, MAX_DISC_LENGTH);
-        strncpy(newMedal->eventTitle, event, MAX_EVENT_LENGTH);
-        strncpy(newMedal->gender, gender, MAX_GENDER);
+        newMedal->discipline = medalIntern(MEDAL_DISCIPLINE, discipline);
+        newMedal->game = medalIntern(MEDAL_GAME, "");
+        newMedal->eventTitle = medalIntern(MEDAL_EVENT, event);
+        newMedal->gender = medalIntern(MEDAL_GENDER, gender);
         newMedal->medalType = medalType;
         newMedal->participantType = participantType;
         strncpy(newMedal->athleteID, athleteId, MAX_ID_LENGTH);
-        strncpy(newMedal->country, country, MAX_COUNTRY_LENGTH);
+        newMedal->country = medalIntern(MEDAL_COUNTRY, country);
+        newMedal->hostIndex = -1;
     }
     return newMedal;
 }
@@ -64,11 +130,26 @@ Medal* createEmptyMedal() {
  * @param medal The Medal to print.
  */
 void printMedal(Medal medal) {
-    printf("Discipline: %s\n", medal.discipline);
-    printf("Event: %s\n", medal.eventTitle);
-    printf("Gender: %s\n", medal.gender);
-    printf("Medal Type: %c\n", medal.medalType);
-    printf("Participant Type: %c\n", medal.participantType);
-    printf("Athlete ID: %s\n", medal.athleteID);
-    printf("Country: %s\n", medal.country);
+    char block[OUTPUT_RECORD_CAPACITY];
+    OutputBuffer out;
+    outputInitBlock(&out, block, OUTPUT_RECORD_CAPACITY);
+
+    formatMedal(&out, &medal);
+
+    outputFree(&out);
+}
+
+/**
+ * @brief Appends the details of a Medal to an output buffer.
+ * @param out The buffer.
+ * @param medal The Medal to print.
+ */
+void formatMedal(OutputBuffer *out, const Medal *medal) {
+    outputPrintf(out, "Discipline: %s\n", medalString(MEDAL_DISCIPLINE, medal->discipline));
+    outputPrintf(out, "Event: %s\n", medalString(MEDAL_EVENT, medal->eventTitle));
+    outputPrintf(out, "Gender: %s\n", medalString(MEDAL_GENDER, medal->gender));
+    outputPrintf(out, "Medal Type: %c\n", medal->medalType);
+    outputPrintf(out, "Participant Type: %c\n", medal->participantType);
+    outputPrintf(out, "Athlete ID: %s\n", medal->athleteID);
+    outputPrintf(out, "Country: %s\n", medalString(MEDAL_COUNTRY, medal->country));
 }
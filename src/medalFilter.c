@@ -0,0 +1,248 @@
+/**
+ * @file medalFilter.c
+ * @brief Implementation of the medal filter pipeline.
+ *
+ * Before scanning the medals, the host based predicates (year range and season)
+ * are evaluated once per host into a set of hosts indexed like Medal.hostIndex,
+ * and the text predicates are turned into codes of the medal dictionaries. Each
+ * predicate is then evaluated over its whole column by a vectorized kernel (see
+ * filterKernels.h), and the selection bitmaps are intersected.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "medalFilter.h"
+#include "filterKernels.h"
+
+#define ANY_CODE -2  ///< Code of a text predicate that is not set.
+
+/**
+ * A filter ready to be evaluated, with the hosts allowed by the host predicates.
+ */
+typedef struct preparedFilter {
+    const MedalFilter *filter;
+    int game;            ///< Code of the game, ANY_CODE or STRING_POOL_NO_CODE (no medal has it).
+    int discipline;      ///< Code of the discipline, same convention as 'game'.
+    int gender;          ///< Code of the gender, same convention as 'game'.
+    int country;         ///< Code of the country, same convention as 'game'.
+    bool usesHosts;      ///< True if medals must belong to an allowed host.
+    int *allowedHosts;   ///< Whether each host (by index) passes the host predicates (0 or 1).
+    int hostCount;       ///< Number of entries in 'allowedHosts'.
+} PreparedFilter;
+
+/**
+ * @brief Initializes a filter that matches every medal.
+ * @param filter The filter to initialize.
+ */
+void medalFilterInit(MedalFilter *filter) {
+    filter->startYear = FILTER_ANY_YEAR;
+    filter->endYear = FILTER_ANY_YEAR;
+    filter->season = NULL;
+    filter->game = NULL;
+    filter->discipline = NULL;
+    filter->gender = NULL;
+    filter->medalType = '\0';
+    filter->country = NULL;
+}
+
+/**
+ * @brief Checks if a filter needs the hosts of the games (year range or season).
+ * @param filter The filter to check.
+ * @return True if the filter has host based predicates, false otherwise.
+ */
+bool medalFilterUsesHosts(const MedalFilter *filter) {
+    return filter->startYear != FILTER_ANY_YEAR || filter->endYear != FILTER_ANY_YEAR || filter->season != NULL;
+}
+
+/**
+ * @brief Checks if a host satisfies the host based predicates of a filter.
+ * @param filter The filter to evaluate.
+ * @param host The host to check.
+ * @return True if the games of the host are allowed, false otherwise.
+ */
+static bool hostMatches(const MedalFilter *filter, const Host *host) {
+    if(filter->season != NULL && strcmp(host->season, filter->season) != 0) return false;
+    if(filter->startYear != FILTER_ANY_YEAR && host->startYear < filter->startYear) return false;
+    if(filter->endYear != FILTER_ANY_YEAR && host->endYear > filter->endYear) return false;
+
+    return true;
+}
+
+/**
+ * @brief Turns a text predicate into a code of a medal dictionary.
+ * @param field The field of the predicate.
+ * @param value The value of the predicate, or NULL if not set.
+ * @return The code of the value, ANY_CODE if not set, or STRING_POOL_NO_CODE if no medal has it.
+ */
+static int predicateCode(MedalField field, const char *value) {
+    return value != NULL ? medalCode(field, value) : ANY_CODE;
+}
+
+/**
+ * @brief Resolves the text predicates of a filter into codes and the host based
+ * predicates into a table of allowed hosts.
+ * @param prepared The prepared filter to initialize.
+ * @param filter The filter to prepare.
+ * @param hosts Mapping of game identifiers to hosts.
+ * @return True if successful, false on memory allocation failure.
+ */
+static bool prepareFilter(PreparedFilter *prepared, const MedalFilter *filter, PtMap hosts) {
+    prepared->filter = filter;
+    prepared->game = predicateCode(MEDAL_GAME, filter->game);
+    prepared->discipline = predicateCode(MEDAL_DISCIPLINE, filter->discipline);
+    prepared->gender = predicateCode(MEDAL_GENDER, filter->gender);
+    prepared->country = predicateCode(MEDAL_COUNTRY, filter->country);
+    prepared->usesHosts = medalFilterUsesHosts(filter);
+    prepared->allowedHosts = NULL;
+    prepared->hostCount = 0;
+
+    if(!prepared->usesHosts) return true;
+
+    // Without hosts no medal is allowed, the table is left empty
+    int hostCount = 0;
+    if(hosts != NULL) mapSize(hosts, &hostCount);
+    if(hostCount == 0) return true;
+
+    prepared->allowedHosts = malloc(hostCount * sizeof(int));
+    if(prepared->allowedHosts == NULL) return false;
+
+    // Hosts are visited in index order, the same numbering used by Medal.hostIndex
+    MapIterator it;
+    mapIterator(hosts, &it);
+
+    const Host *host;
+    for(int h = 0; mapIteratorNext(&it, NULL, &host); h++) prepared->allowedHosts[h] = hostMatches(filter, host);
+    prepared->hostCount = hostCount;
+
+    return true;
+}
+
+/**
+ * @brief Releases the memory held by a prepared filter.
+ * @param prepared The prepared filter.
+ */
+static void releaseFilter(PreparedFilter *prepared) {
+    free(prepared->allowedHosts);
+}
+
+/**
+ * @brief Evaluates every predicate of a prepared filter, one column at a time.
+ * @param prepared The prepared filter.
+ * @param columns The columns of the medals.
+ * @param bitmap Bitmap of BITMAP_WORDS(columns->size) words that receives the matches.
+ * @return True if successful, false on memory allocation failure.
+ */
+static bool selectMedals(const PreparedFilter *prepared, const MedalColumns *columns, uint64_t *bitmap) {
+    const MedalFilter *filter = prepared->filter;
+    int size = columns->size, words = BITMAP_WORDS(size);
+
+    uint64_t *selection = malloc((words > 0 ? words : 1) * sizeof(uint64_t));
+    if(selection == NULL) return false;
+
+    // Every row matches until a predicate rules it out
+    for(int w = 0; w < words; w++) bitmap[w] = ~(uint64_t)0;
+    if(size % 64 != 0) bitmap[words - 1] = ((uint64_t)1 << (size % 64)) - 1;
+
+    if(filter->medalType != '\0') {
+        kernelEqualsChar(columns->medalType, size, filter->medalType, selection);
+        bitmapAnd(bitmap, selection, words);
+    }
+
+    // Unknown values (STRING_POOL_NO_CODE) are never stored, so they select nothing
+    const int *codeColumns[] = { columns->game, columns->discipline, columns->gender, columns->country };
+    int codes[] = { prepared->game, prepared->discipline, prepared->gender, prepared->country };
+    for(int c = 0; c < 4; c++) {
+        if(codes[c] == ANY_CODE) continue;
+
+        kernelEqualsInt(codeColumns[c], size, codes[c], selection);
+        bitmapAnd(bitmap, selection, words);
+    }
+
+    // Medals without a host have a negative index, which is never in the set
+    if(prepared->usesHosts) {
+        kernelInSet(columns->hostIndex, size, prepared->allowedHosts, prepared->hostCount, selection);
+        bitmapAnd(bitmap, selection, words);
+    }
+
+    free(selection);
+
+    return true;
+}
+
+/**
+ * @brief Evaluates a prepared filter over a list of medals.
+ * @param filter The predicates to evaluate.
+ * @param medals The medals to filter.
+ * @param hosts Mapping of game identifiers to hosts (may be NULL if not used by the filter).
+ * @param ptWords Pointer to store the number of words of the bitmap.
+ * @return Bitmap of the matches, or NULL on memory allocation failure.
+ */
+static uint64_t* filterBitmap(const MedalFilter *filter, PtListMedal medals, PtMap hosts, int *ptWords) {
+    MedalColumns columns;
+    listMedalColumns(medals, &columns);
+
+    int words = BITMAP_WORDS(columns.size);
+    uint64_t *bitmap = malloc((words > 0 ? words : 1) * sizeof(uint64_t));
+    if(bitmap == NULL) return NULL;
+
+    PreparedFilter prepared;
+    if(!prepareFilter(&prepared, filter, hosts)) {
+        free(bitmap);
+        return NULL;
+    }
+
+    bool ok = selectMedals(&prepared, &columns, bitmap);
+    releaseFilter(&prepared);
+
+    if(!ok) {
+        free(bitmap);
+        return NULL;
+    }
+
+    *ptWords = words;
+    return bitmap;
+}
+
+/**
+ * @brief Evaluates a filter over a list of medals and returns the matching rows.
+ * @param filter The predicates to evaluate.
+ * @param medals The medals to filter.
+ * @param hosts Mapping of game identifiers to hosts (may be NULL if not used by the filter).
+ * @param ptCount Pointer to store the number of matching rows.
+ * @return Array with the matching rows in ascending order, or NULL on memory allocation failure.
+ */
+int* medalFilterRows(const MedalFilter *filter, PtListMedal medals, PtMap hosts, int *ptCount) {
+    *ptCount = 0;
+    if(filter == NULL || medals == NULL) return NULL;
+
+    int words = 0;
+    uint64_t *bitmap = filterBitmap(filter, medals, hosts, &words);
+    if(bitmap == NULL) return NULL;
+
+    // The matches are usually a small fraction, count them first to allocate only what is needed
+    int count = bitmapCount(bitmap, words);
+    int *rows = malloc((count > 0 ? count : 1) * sizeof(int));
+
+    if(rows != NULL) *ptCount = bitmapToRows(bitmap, words, rows);
+    free(bitmap);
+
+    return rows;
+}
+
+/**
+ * @brief Evaluates a filter over a list of medals and returns a bitmap of the matches.
+ * @param filter The predicates to evaluate.
+ * @param medals The medals to filter.
+ * @param hosts Mapping of game identifiers to hosts (may be NULL if not used by the filter).
+ * @param ptCount Pointer to store the number of matching rows.
+ * @return Bitmap of (size + 63) / 64 words, or NULL on memory allocation failure.
+ */
+uint64_t* medalFilterBitmap(const MedalFilter *filter, PtListMedal medals, PtMap hosts, int *ptCount) {
+    *ptCount = 0;
+    if(filter == NULL || medals == NULL) return NULL;
+
+    int words = 0;
+    uint64_t *bitmap = filterBitmap(filter, medals, hosts, &words);
+    if(bitmap != NULL) *ptCount = bitmapCount(bitmap, words);
+
+    return bitmap;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file outputBuffer.c
+ * @brief Implementation of the buffered output of reports and tables.
+ *
+ * Text is formatted with vsnprintf straight into the free end of the block.
+ * A flush drains the stdio buffer of stdout and then writes the whole block
+ * with write(2), retrying after partial writes and interruptions.
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "outputBuffer.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+    #include <io.h>
+    #define STDOUT_FILENO 1
+    #define write _write
+#else
+    #include <errno.h>
+    #include <unistd.h>
+#endif
+
+/**
+ * @brief Writes bytes to the standard output, all of them.
+ * @param data The bytes.
+ * @param length Number of bytes.
+ * @return True if successful, false on a write error.
+ */
+static bool writeAll(const char *data, size_t length) {
+    while(length > 0) {
+        int written = write(STDOUT_FILENO, data, length);
+
+        if(written < 0) {
+        #if !defined(_WIN32) && !defined(_WIN64)
+            if(errno == EINTR) continue;
+        #endif
+            return false;
+        }
+
+        data += written;
+        length -= written;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Initializes an empty buffer.
+ * @param out The buffer.
+ * @param capacity Size of the block to allocate, e.g., OUTPUT_BUFFER_CAPACITY.
+ */
+void outputInit(OutputBuffer *out, size_t capacity) {
+    out->data = malloc(capacity);
+    out->length = 0;
+    out->capacity = out->data != NULL ? capacity : 0;
+    out->owned = true;
+}
+
+/**
+ * @brief Initializes an empty buffer that keeps its text in a block of the caller.
+ * @param out The buffer.
+ * @param block The block that receives the text.
+ * @param capacity Size of 'block'.
+ */
+void outputInitBlock(OutputBuffer *out, char *block, size_t capacity) {
+    out->data = block;
+    out->length = 0;
+    out->capacity = capacity;
+    out->owned = false;
+}
+
+/**
+ * @brief Appends formatted text to a buffer, like printf.
+ * @param out The buffer.
+ * @param format The format string, followed by its arguments.
+ */
+void outputPrintf(OutputBuffer *out, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if(out->data == NULL) {
+        vprintf(format, args);
+        va_end(args);
+        return;
+    }
+
+    va_list retry;
+    va_copy(retry, args);
+
+    int length = vsnprintf(out->data + out->length, out->capacity - out->length, format, args);
+    va_end(args);
+
+    // The text was cut short, make room and format it again
+    if(length >= 0 && (size_t)length >= out->capacity - out->length) {
+        outputFlush(out);
+
+        if((size_t)length >= out->capacity) {
+            // The text was flushed, so a block of the caller is replaced without copying
+            char *data = out->owned ? realloc(out->data, length + 1) : malloc(length + 1);
+
+            if(data == NULL) {
+                vprintf(format, retry);
+                va_end(retry);
+                return;
+            }
+
+            out->data = data;
+            out->capacity = length + 1;
+            out->owned = true;
+        }
+
+        vsnprintf(out->data, out->capacity, format, retry);
+    }
+
+    va_end(retry);
+
+    if(length > 0) out->length += length;
+}
+
+/**
+ * @brief Appends the ANSI sequence that clears the terminal to a buffer.
+ * @param out The buffer.
+ */
+void outputClearScreen(OutputBuffer *out) {
+    outputPrintf(out, "%s", ANSI_CLEAR_SCREEN);
+}
+
+/**
+ * @brief Writes the text of a buffer to the standard output and empties it.
+ * @param out The buffer.
+ * @return True if successful, false if the text could not be written.
+ */
+bool outputFlush(OutputBuffer *out) {
+    // Text printed with stdio before this buffer goes out first
+    fflush(stdout);
+
+    if(out->length == 0) return true;
+
+    bool written = writeAll(out->data, out->length);
+    out->length = 0;
+
+    return written;
+}
+
+/**
+ * @brief Flushes a buffer and frees the memory it allocated.
+ * @param out The buffer.
+ */
+void outputFree(OutputBuffer *out) {
+    outputFlush(out);
+
+    if(out->owned) free(out->data);
+    out->data = NULL;
+    out->length = 0;
+    out->capacity = 0;
+}
@@ -0,0 +1,567 @@
+/**
+ * @file snapshot.c
+ * @brief Implementation of the binary snapshots of imported data.
+ *
+ * A snapshot file is laid out as a fixed header, a table of sections and the
+ * section payloads. The header records the size and modification time (with
+ * nanoseconds where the platform keeps them) of the CSV file it was made from;
+ * each section holds an array of fixed-size elements (records, or indexes
+ * built over them) together with a checksum.
+ * Snapshots are written to a temporary file and renamed into place, so a
+ * crash while saving never leaves a half-written snapshot behind.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include "snapshot.h"
+#include "athlete.h"
+#include "medal.h"
+#include "host.h"
+
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+    #define SNAPSHOT_USE_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#define SNAPSHOT_MAGIC "OSPSNAP"
+#define SNAPSHOT_EXTENSION ".snap"
+#define MAX_SNAPSHOT_PATH 256
+#define MAX_SNAPSHOT_SECTIONS 8
+
+#define SECTION_ATHLETES 1
+#define SECTION_MEDALS 2
+#define SECTION_HOSTS 3
+#define SECTION_MEDAL_STRING_COUNTS 4  ///< Number of strings of each medal dictionary.
+#define SECTION_MEDAL_STRINGS 5        ///< Strings of the medal dictionaries, NUL-terminated, in code order.
+#define SECTION_ATHLETE_ID_INDEX 6     ///< Entries of the ID index of the athletes (see listIdIndex).
+#define SECTION_MEDAL_ATHLETE_ROWS 7   ///< Rows of the medals grouped by athlete (see listMedalAthleteIndex).
+#define SECTION_MEDAL_ATHLETE_GROUPS 8 ///< Start of each athlete in the grouped rows, plus the total.
+
+typedef struct snapshotHeader {
+    char magic[8];            ///< SNAPSHOT_MAGIC.
+    uint32_t version;         ///< SNAPSHOT_VERSION of the program that wrote it.
+    uint32_t sectionCount;    ///< Number of entries in the section table.
+    uint64_t sourceSize;      ///< Size of the CSV file the snapshot was made from.
+    int64_t sourceMtime;      ///< Modification time of that CSV file, in seconds.
+    int64_t sourceMtimeNsec;  ///< Nanoseconds of that modification time, or 0 if the platform does not keep them.
+} SnapshotHeader;
+
+typedef struct snapshotSection {
+    uint32_t id;         ///< What the section holds (SECTION_*).
+    uint32_t elemSize;   ///< Size of each element, guards against layout changes.
+    uint64_t count;      ///< Number of elements.
+    uint64_t offset;     ///< Offset of the first element from the start of the file.
+    uint64_t checksum;   ///< Checksum of the payload.
+} SnapshotSection;
+
+/**
+ * Section to be written, with its payload in memory.
+ */
+typedef struct snapshotBlock {
+    uint32_t id;
+    uint32_t elemSize;
+    uint64_t count;
+    const void *data;
+} SnapshotBlock;
+
+/**
+ * Snapshot file mapped into memory.
+ */
+typedef struct mappedSnapshot {
+    const char *data;
+    size_t size;
+    bool mapped;
+} MappedSnapshot;
+
+/**
+ * @brief Computes a 64-bit FNV-1a style checksum, a word at a time.
+ * @param data Data to hash.
+ * @param size Number of bytes.
+ * @return The checksum.
+ */
+static uint64_t checksum(const void *data, size_t size) {
+    const unsigned char *p = (const unsigned char*)data;
+    uint64_t hash = 1469598103934665603ULL;
+
+    size_t words = size / sizeof(uint64_t);
+    for(size_t i = 0; i < words; i++) {
+        uint64_t word;
+        memcpy(&word, p + i * sizeof(uint64_t), sizeof(uint64_t));
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+
+    for(size_t i = words * sizeof(uint64_t); i < size; i++)
+        hash = (hash ^ p[i]) * 1099511628211ULL;
+
+    return hash;
+}
+
+/**
+ * @brief Builds the snapshot path for a CSV file (e.g., data/hosts.csv -> data/hosts.snap).
+ * @param sourcePath Path of the CSV file.
+ * @param path Buffer of MAX_SNAPSHOT_PATH characters that receives the path.
+ */
+static void snapshotPath(const char *sourcePath, char *path) {
+    snprintf(path, MAX_SNAPSHOT_PATH, "%s", sourcePath);
+
+    char *extension = strrchr(path, '.');
+    if(extension != NULL && strchr(extension, '/') == NULL) *extension = '\0';
+
+    strncat(path, SNAPSHOT_EXTENSION, MAX_SNAPSHOT_PATH - strlen(path) - 1);
+}
+
+/**
+ * @brief Reads the size and modification time of the CSV file a snapshot stands for.
+ * @param sourcePath Path of the CSV file.
+ * @param header Header whose source fields are filled.
+ * @return True if the file exists, false otherwise.
+ */
+static bool readSourceStamp(const char *sourcePath, SnapshotHeader *header) {
+    struct stat st;
+    if(stat(sourcePath, &st) != 0) return false;
+
+    header->sourceSize = st.st_size;
+    header->sourceMtime = st.st_mtime;
+
+    // A file rewritten within the same second is told apart by the nanoseconds
+#if defined(__APPLE__)
+    header->sourceMtimeNsec = st.st_mtimespec.tv_nsec;
+#elif defined(__linux__) || defined(__unix__)
+    header->sourceMtimeNsec = st.st_mtim.tv_nsec;
+#else
+    header->sourceMtimeNsec = 0;
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Writes a snapshot made of the given sections.
+ * @param sourcePath Path of the CSV file the data was imported from.
+ * @param blocks Sections to write.
+ * @param blockCount Number of sections.
+ * @return True if the snapshot was written, false otherwise.
+ */
+static bool writeSnapshot(const char *sourcePath, const SnapshotBlock *blocks, int blockCount) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(SnapshotHeader));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.sectionCount = blockCount;
+
+    if(!readSourceStamp(sourcePath, &header)) return false;
+
+    SnapshotSection sections[MAX_SNAPSHOT_SECTIONS];
+    uint64_t offset = sizeof(SnapshotHeader) + blockCount * sizeof(SnapshotSection);
+    for(int i = 0; i < blockCount; i++) {
+        uint64_t size = blocks[i].count * blocks[i].elemSize;
+
+        sections[i].id = blocks[i].id;
+        sections[i].elemSize = blocks[i].elemSize;
+        sections[i].count = blocks[i].count;
+        sections[i].offset = offset;
+        sections[i].checksum = checksum(blocks[i].data, size);
+
+        // Keep every payload 8-byte aligned
+        offset += (size + 7) & ~(uint64_t)7;
+    }
+
+    char path[MAX_SNAPSHOT_PATH], tempPath[MAX_SNAPSHOT_PATH + 4];
+    snapshotPath(sourcePath, path);
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+
+    FILE *fs = fopen(tempPath, "wb");
+    if(fs == NULL) return false;
+
+    bool ok = fwrite(&header, sizeof(SnapshotHeader), 1, fs) == 1;
+    if(blockCount > 0)
+        ok = ok && fwrite(sections, sizeof(SnapshotSection), blockCount, fs) == (size_t)blockCount;
+
+    static const char padding[8] = { 0 };
+    for(int i = 0; i < blockCount && ok; i++) {
+        uint64_t size = blocks[i].count * blocks[i].elemSize;
+
+        if(size > 0) ok = fwrite(blocks[i].data, 1, size, fs) == size;
+        if(ok && size % 8 != 0) ok = fwrite(padding, 1, 8 - size % 8, fs) == 8 - size % 8;
+    }
+
+    ok = (fclose(fs) == 0) && ok;
+
+    if(!ok || rename(tempPath, path) != 0) {
+        remove(tempPath);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Unmaps a snapshot opened with openSnapshot.
+ * @param snapshot Snapshot to close.
+ */
+static void closeSnapshot(MappedSnapshot *snapshot) {
+    if(snapshot->data == NULL) return;
+
+#ifdef SNAPSHOT_USE_MMAP
+    if(snapshot->mapped) munmap((void*)snapshot->data, snapshot->size);
+    else free((void*)snapshot->data);
+#else
+    free((void*)snapshot->data);
+#endif
+
+    snapshot->data = NULL;
+}
+
+/**
+ * @brief Maps a snapshot into memory and validates it.
+ * The snapshot is rejected if its header, version or any section is invalid,
+ * if a checksum does not match, or if the CSV file changed since it was written.
+ * @param sourcePath Path of the CSV file the snapshot was made from.
+ * @param snapshot Receives the mapped snapshot.
+ * @return True if the snapshot is valid and up to date, false otherwise.
+ */
+static bool openSnapshot(const char *sourcePath, MappedSnapshot *snapshot) {
+    char path[MAX_SNAPSHOT_PATH];
+    snapshotPath(sourcePath, path);
+
+    snapshot->data = NULL;
+    snapshot->size = 0;
+    snapshot->mapped = false;
+
+#ifdef SNAPSHOT_USE_MMAP
+    int fd = open(path, O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(SnapshotHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(data == MAP_FAILED) return false;
+
+    snapshot->data = data;
+    snapshot->size = st.st_size;
+    snapshot->mapped = true;
+#else
+    FILE *fs = fopen(path, "rb");
+    if(fs == NULL) return false;
+
+    fseek(fs, 0, SEEK_END);
+    long size = ftell(fs);
+    fseek(fs, 0, SEEK_SET);
+
+    char *data = size >= (long)sizeof(SnapshotHeader) ? malloc(size) : NULL;
+    if(data == NULL || fread(data, 1, size, fs) != (size_t)size) {
+        free(data);
+        fclose(fs);
+        return false;
+    }
+    fclose(fs);
+
+    snapshot->data = data;
+    snapshot->size = size;
+#endif
+
+    const SnapshotHeader *header = (const SnapshotHeader*)snapshot->data;
+
+    SnapshotHeader current;
+    bool valid = memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0
+        && header->version == SNAPSHOT_VERSION
+        && header->sectionCount <= MAX_SNAPSHOT_SECTIONS
+        && sizeof(SnapshotHeader) + header->sectionCount * sizeof(SnapshotSection) <= snapshot->size
+        && readSourceStamp(sourcePath, &current)
+        && current.sourceSize == header->sourceSize
+        && current.sourceMtime == header->sourceMtime
+        && current.sourceMtimeNsec == header->sourceMtimeNsec;
+
+    const SnapshotSection *sections = (const SnapshotSection*)(snapshot->data + sizeof(SnapshotHeader));
+    for(uint32_t i = 0; valid && i < header->sectionCount; i++) {
+        uint64_t size = sections[i].count * sections[i].elemSize;
+
+        valid = sections[i].elemSize > 0
+            && sections[i].count <= snapshot->size / sections[i].elemSize
+            && sections[i].offset <= snapshot->size
+            && size <= snapshot->size - sections[i].offset
+            && checksum(snapshot->data + sections[i].offset, size) == sections[i].checksum;
+    }
+
+    if(!valid) closeSnapshot(snapshot);
+
+    return valid;
+}
+
+/**
+ * @brief Finds a section of a validated snapshot.
+ * @param snapshot Snapshot opened with openSnapshot.
+ * @param id Section to find.
+ * @param elemSize Expected size of each element.
+ * @param ptCount Address of variable to hold the number of elements.
+ * @return Pointer to the first element, or NULL if the section is missing or has another layout.
+ */
+static const void* findSection(const MappedSnapshot *snapshot, uint32_t id, uint32_t elemSize, uint64_t *ptCount) {
+    const SnapshotHeader *header = (const SnapshotHeader*)snapshot->data;
+    const SnapshotSection *sections = (const SnapshotSection*)(snapshot->data + sizeof(SnapshotHeader));
+
+    for(uint32_t i = 0; i < header->sectionCount; i++) {
+        if(sections[i].id != id) continue;
+        if(sections[i].elemSize != elemSize) return NULL;
+
+        *ptCount = sections[i].count;
+        return snapshot->data + sections[i].offset;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Writes a snapshot of a list of athletes.
+ * @param athletes The athletes to save.
+ * @param sourcePath Path of the CSV file the athletes were imported from.
+ * @return True if the snapshot was written, false otherwise.
+ */
+bool snapshotSaveAthletes(PtList athletes, const char *sourcePath) {
+    int size = 0;
+    if(listSize(athletes, &size) != LIST_OK) return false;
+
+    Athlete *records = malloc((size > 0 ? size : 1) * sizeof(Athlete));
+    if(records == NULL) return false;
+
+    int *slots = NULL, slotCount = 0;
+    if(listIdIndex(athletes, &slots, &slotCount) != LIST_OK) {
+        free(records);
+        return false;
+    }
+
+    for(int i = 0; i < size; i++)
+        listGet(athletes, i, &records[i]);
+
+    SnapshotBlock blocks[] = {
+        { SECTION_ATHLETES, sizeof(Athlete), size, records },
+        { SECTION_ATHLETE_ID_INDEX, sizeof(int), slotCount, slots }
+    };
+    bool ok = writeSnapshot(sourcePath, blocks, 2);
+
+    free(records);
+    free(slots);
+    return ok;
+}
+
+/**
+ * @brief Loads a list of athletes from its snapshot.
+ * @param sourcePath Path of the CSV file the snapshot was made from.
+ * @return A list of athletes, or NULL if there is no valid, up-to-date snapshot.
+ */
+PtList snapshotLoadAthletes(const char *sourcePath) {
+    MappedSnapshot snapshot;
+    if(!openSnapshot(sourcePath, &snapshot)) return NULL;
+
+    uint64_t count = 0, slotCount = 0;
+    const Athlete *records = findSection(&snapshot, SECTION_ATHLETES, sizeof(Athlete), &count);
+    const int *slots = findSection(&snapshot, SECTION_ATHLETE_ID_INDEX, sizeof(int), &slotCount);
+
+    PtList athletes = records != NULL && count <= INT_MAX ? listCreate() : NULL;
+
+    // The saved index is adopted if it fits the records, otherwise the IDs are hashed again
+    int error = LIST_OK;
+    if(athletes != NULL && slots != NULL && slotCount <= INT_MAX)
+        error = listAppendNIndexed(athletes, records, (int)count, slots, (int)slotCount);
+    else if(athletes != NULL)
+        error = listAppendN(athletes, records, (int)count);
+
+    if(error != LIST_OK) listDestroy(&athletes);
+
+    closeSnapshot(&snapshot);
+    return athletes;
+}
+
+/**
+ * @brief Writes a snapshot of a list of medals.
+ * @param medals The medals to save.
+ * @param sourcePath Path of the CSV file the medals were imported from.
+ * @return True if the snapshot was written, false otherwise.
+ */
+bool snapshotSaveMedals(PtListMedal medals, const char *sourcePath) {
+    int size = 0;
+    if(listMedalSize(medals, &size) != LIST_OK) return false;
+
+    // Medals hold codes, the dictionaries are saved with them to decode them on load
+    uint32_t stringCounts[MEDAL_FIELD_COUNT];
+    size_t stringsSize = 0;
+    for(int f = 0; f < MEDAL_FIELD_COUNT; f++) {
+        stringCounts[f] = medalStringCount(f);
+
+        for(uint32_t c = 0; c < stringCounts[f]; c++)
+            stringsSize += strlen(medalString(f, c)) + 1;
+    }
+
+    const int *athleteRows = NULL, *groupStart = NULL;
+    int groupCount = 0;
+    if(listMedalAthleteIndex(medals, &athleteRows, &groupStart, &groupCount) != LIST_OK) return false;
+
+    Medal *records = malloc((size > 0 ? size : 1) * sizeof(Medal));
+    char *strings = malloc(stringsSize > 0 ? stringsSize : 1);
+    if(records == NULL || strings == NULL) {
+        free(records);
+        free(strings);
+        return false;
+    }
+
+    for(int i = 0; i < size; i++)
+        listMedalGet(medals, i, &records[i]);
+
+    char *next = strings;
+    for(int f = 0; f < MEDAL_FIELD_COUNT; f++) {
+        for(uint32_t c = 0; c < stringCounts[f]; c++) {
+            size_t length = strlen(medalString(f, c)) + 1;
+            memcpy(next, medalString(f, c), length);
+            next += length;
+        }
+    }
+
+    SnapshotBlock blocks[] = {
+        { SECTION_MEDALS, sizeof(Medal), size, records },
+        { SECTION_MEDAL_STRING_COUNTS, sizeof(uint32_t), MEDAL_FIELD_COUNT, stringCounts },
+        { SECTION_MEDAL_STRINGS, 1, stringsSize, strings },
+        { SECTION_MEDAL_ATHLETE_ROWS, sizeof(int), size, athleteRows },
+        { SECTION_MEDAL_ATHLETE_GROUPS, sizeof(int), groupCount + 1, groupStart }
+    };
+    bool ok = writeSnapshot(sourcePath, blocks, 5);
+
+    free(records);
+    free(strings);
+    return ok;
+}
+
+/**
+ * @brief Interns the saved medal dictionaries, mapping each saved code to the current one.
+ * @param counts Number of saved strings of each field.
+ * @param strings Saved strings, NUL-terminated, in field and code order.
+ * @param stringsSize Size of 'strings' in bytes.
+ * @param codes Array of MEDAL_FIELD_COUNT entries that receives the code maps (to be freed by the caller).
+ * @return True if successful, false if the strings are corrupt or memory allocation fails.
+ */
+static bool loadMedalStrings(const uint32_t *counts, const char *strings, uint64_t stringsSize, int **codes) {
+    uint64_t position = 0;
+    bool ok = true;
+
+    for(int f = 0; f < MEDAL_FIELD_COUNT; f++) codes[f] = NULL;
+
+    for(int f = 0; f < MEDAL_FIELD_COUNT && ok; f++) {
+        ok = counts[f] <= stringsSize;
+        if(ok) codes[f] = malloc((counts[f] > 0 ? counts[f] : 1) * sizeof(int));
+        ok = ok && codes[f] != NULL;
+
+        for(uint32_t c = 0; c < counts[f] && ok; c++) {
+            const char *end = position < stringsSize ? memchr(strings + position, '\0', stringsSize - position) : NULL;
+            ok = end != NULL;
+            if(!ok) break;
+
+            codes[f][c] = medalIntern(f, strings + position);
+            ok = codes[f][c] != STRING_POOL_NO_CODE;
+            position = end - strings + 1;
+        }
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Loads a list of medals from its snapshot.
+ * @param sourcePath Path of the CSV file the snapshot was made from.
+ * @return A list of medals, or NULL if there is no valid, up-to-date snapshot.
+ */
+PtListMedal snapshotLoadMedals(const char *sourcePath) {
+    MappedSnapshot snapshot;
+    if(!openSnapshot(sourcePath, &snapshot)) return NULL;
+
+    uint64_t count = 0, countsCount = 0, stringsSize = 0, rowsCount = 0, groupsCount = 0;
+    const Medal *records = findSection(&snapshot, SECTION_MEDALS, sizeof(Medal), &count);
+    const uint32_t *stringCounts = findSection(&snapshot, SECTION_MEDAL_STRING_COUNTS, sizeof(uint32_t), &countsCount);
+    const char *strings = findSection(&snapshot, SECTION_MEDAL_STRINGS, 1, &stringsSize);
+    const int *athleteRows = findSection(&snapshot, SECTION_MEDAL_ATHLETE_ROWS, sizeof(int), &rowsCount);
+    const int *groupStart = findSection(&snapshot, SECTION_MEDAL_ATHLETE_GROUPS, sizeof(int), &groupsCount);
+
+    int *codes[MEDAL_FIELD_COUNT] = { NULL };
+    bool ok = records != NULL && stringCounts != NULL && strings != NULL && countsCount == MEDAL_FIELD_COUNT
+        && loadMedalStrings(stringCounts, strings, stringsSize, codes);
+
+    PtListMedal medals = ok && count <= INT_MAX ? listMedalCreate() : NULL;
+    if(medals != NULL && listMedalReserve(medals, (int)count) != LIST_OK)
+        listMedalDestroy(&medals);
+
+    for(uint64_t i = 0; medals != NULL && i < count; i++) {
+        Medal medal = records[i];
+
+        for(int f = 0; f < MEDAL_FIELD_COUNT && ok; f++) {
+            int *code = medalFieldCode(&medal, f);
+
+            ok = *code >= 0 && (uint32_t)*code < stringCounts[f];
+            if(ok) *code = codes[f][*code];
+        }
+
+        if(!ok || listMedalAppend(medals, medal) != LIST_OK) {
+            listMedalDestroy(&medals);
+            break;
+        }
+    }
+
+    // The athlete ordinals follow the order of the rows, so the saved index still applies
+    if(medals != NULL && athleteRows != NULL && groupStart != NULL && rowsCount == count
+        && groupsCount > 0 && groupsCount <= INT_MAX
+        && listMedalSetAthleteIndex(medals, athleteRows, groupStart, (int)groupsCount - 1) != LIST_OK)
+        listMedalDestroy(&medals);
+
+    for(int f = 0; f < MEDAL_FIELD_COUNT; f++) free(codes[f]);
+
+    closeSnapshot(&snapshot);
+    return medals;
+}
+
+/**
+ * @brief Writes a snapshot of a map of hosts.
+ * @param hosts The hosts to save.
+ * @param sourcePath Path of the CSV file the hosts were imported from.
+ * @return True if the snapshot was written, false otherwise.
+ */
+bool snapshotSaveHosts(PtMap hosts, const char *sourcePath) {
+    int size = 0;
+    if(mapSize(hosts, &size) != MAP_OK) return false;
+
+    MapValue *records = mapValues(hosts);
+    if(records == NULL && size > 0) return false;
+
+    SnapshotBlock block = { SECTION_HOSTS, sizeof(Host), size, records };
+    bool ok = writeSnapshot(sourcePath, &block, 1);
+
+    free(records);
+    return ok;
+}
+
+/**
+ * @brief Loads a map of hosts from its snapshot.
+ * @param sourcePath Path of the CSV file the snapshot was made from.
+ * @return A map of hosts, or NULL if there is no valid, up-to-date snapshot.
+ */
+PtMap snapshotLoadHosts(const char *sourcePath) {
+    MappedSnapshot snapshot;
+    if(!openSnapshot(sourcePath, &snapshot)) return NULL;
+
+    uint64_t count = 0;
+    const Host *records = findSection(&snapshot, SECTION_HOSTS, sizeof(Host), &count);
+
+    PtMap hosts = records != NULL ? mapCreate() : NULL;
+    for(uint64_t i = 0; hosts != NULL && i < count; i++)
+        mapPut(hosts, (MapKey)records[i].gameSlug, records[i]);
+
+    closeSnapshot(&snapshot);
+    return hosts;
+}
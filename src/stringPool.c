@@ -0,0 +1,211 @@
+/**
+ * @file stringPool.c
+ * @brief Implementation of the ADT StringPool with an open addressing hash table.
+ *
+ * Every string is copied once into its own allocation and its address is kept
+ * in an array indexed by code. A table of hash slots, probed linearly, maps a
+ * string back to its code. The table is kept at most half full.
+ */
+#include "stringPool.h"
+#include "helpers.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INITIAL_CAPACITY 16
+#define INITIAL_SLOTS 32  ///< Must be a power of two.
+
+#define EMPTY_SLOT -1
+
+typedef struct stringPoolImpl {
+    char **strings;         ///< Interned strings, indexed by code.
+    unsigned int *hashes;   ///< Hash of each string, indexed by code.
+    int size;               ///< Number of strings.
+    int capacity;           ///< Capacity of 'strings' and 'hashes'.
+    int *slots;             ///< Hash slots holding a code, or EMPTY_SLOT.
+    int slotCount;          ///< Number of slots, always a power of two.
+} StringPoolImpl;
+
+/**
+ * @brief Finds the slot of a string, or the empty slot where it would go.
+ * @param pool The pool.
+ * @param str The string to find.
+ * @param hash Hash of the string.
+ * @return Index of the slot.
+ */
+static int findSlot(PtStringPool pool, const char *str, unsigned int hash) {
+    int mask = pool->slotCount - 1;
+    int slot = hash & mask;
+
+    while (pool->slots[slot] != EMPTY_SLOT) {
+        int code = pool->slots[slot];
+        if (pool->hashes[code] == hash && strcmp(pool->strings[code], str) == 0) break;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Doubles the number of slots and reinserts every code.
+ * @param pool The pool.
+ * @return True if successful, false on memory allocation failure.
+ */
+static bool growSlots(PtStringPool pool) {
+    int slotCount = pool->slotCount * 2;
+    int *slots = malloc(slotCount * sizeof(int));
+    if (slots == NULL) return false;
+
+    for (int i = 0; i < slotCount; i++) slots[i] = EMPTY_SLOT;
+
+    for (int code = 0; code < pool->size; code++) {
+        int slot = pool->hashes[code] & (slotCount - 1);
+        while (slots[slot] != EMPTY_SLOT) slot = (slot + 1) & (slotCount - 1);
+
+        slots[slot] = code;
+    }
+
+    free(pool->slots);
+    pool->slots = slots;
+    pool->slotCount = slotCount;
+
+    return true;
+}
+
+/**
+ * @brief Makes room for one more string.
+ * @param pool The pool.
+ * @return True if successful, false on memory allocation failure.
+ */
+static bool ensureCapacity(PtStringPool pool) {
+    if ((pool->size + 1) * 2 > pool->slotCount && !growSlots(pool)) return false;
+    if (pool->size < pool->capacity) return true;
+
+    int capacity = pool->capacity * 2;
+    char **strings = realloc(pool->strings, capacity * sizeof(char*));
+    if (strings == NULL) return false;
+    pool->strings = strings;
+
+    unsigned int *hashes = realloc(pool->hashes, capacity * sizeof(unsigned int));
+    if (hashes == NULL) return false;
+    pool->hashes = hashes;
+
+    pool->capacity = capacity;
+
+    return true;
+}
+
+/**
+ * @brief Creates a new empty string pool.
+ * @return Pointer to the created pool or NULL if memory allocation fails.
+ */
+PtStringPool stringPoolCreate() {
+    PtStringPool pool = malloc(sizeof(StringPoolImpl));
+    if (pool == NULL) return NULL;
+
+    pool->strings = malloc(INITIAL_CAPACITY * sizeof(char*));
+    pool->hashes = malloc(INITIAL_CAPACITY * sizeof(unsigned int));
+    pool->slots = malloc(INITIAL_SLOTS * sizeof(int));
+
+    if (pool->strings == NULL || pool->hashes == NULL || pool->slots == NULL) {
+        free(pool->strings);
+        free(pool->hashes);
+        free(pool->slots);
+        free(pool);
+        return NULL;
+    }
+
+    for (int i = 0; i < INITIAL_SLOTS; i++) pool->slots[i] = EMPTY_SLOT;
+
+    pool->size = 0;
+    pool->capacity = INITIAL_CAPACITY;
+    pool->slotCount = INITIAL_SLOTS;
+
+    return pool;
+}
+
+/**
+ * @brief Frees a string pool and every string it holds.
+ * @param ptPool Address of the pointer to the pool.
+ */
+void stringPoolDestroy(PtStringPool *ptPool) {
+    if (ptPool == NULL || *ptPool == NULL) return;
+
+    PtStringPool pool = *ptPool;
+
+    for (int i = 0; i < pool->size; i++) free(pool->strings[i]);
+
+    free(pool->strings);
+    free(pool->hashes);
+    free(pool->slots);
+    free(pool);
+
+    *ptPool = NULL;
+}
+
+/**
+ * @brief Returns the code of a string, adding it to the pool if needed.
+ * @param pool The pool.
+ * @param str The string to intern.
+ * @return The code of the string, or STRING_POOL_NO_CODE if memory allocation fails.
+ */
+int stringPoolIntern(PtStringPool pool, const char *str) {
+    if (pool == NULL || str == NULL) return STRING_POOL_NO_CODE;
+
+    unsigned int hash = hashString(str);
+    int slot = findSlot(pool, str, hash);
+    if (pool->slots[slot] != EMPTY_SLOT) return pool->slots[slot];
+
+    if (!ensureCapacity(pool)) return STRING_POOL_NO_CODE;
+
+    size_t length = strlen(str);
+    char *copy = malloc(length + 1);
+    if (copy == NULL) return STRING_POOL_NO_CODE;
+    memcpy(copy, str, length + 1);
+
+    // The slots may have been rehashed to make room
+    slot = findSlot(pool, str, hash);
+
+    int code = pool->size++;
+    pool->strings[code] = copy;
+    pool->hashes[code] = hash;
+    pool->slots[slot] = code;
+
+    return code;
+}
+
+/**
+ * @brief Returns the code of a string without adding it to the pool.
+ * @param pool The pool.
+ * @param str The string to find.
+ * @return The code of the string, or STRING_POOL_NO_CODE if it is not in the pool.
+ */
+int stringPoolFind(PtStringPool pool, const char *str) {
+    if (pool == NULL || str == NULL) return STRING_POOL_NO_CODE;
+
+    int slot = findSlot(pool, str, hashString(str));
+
+    return pool->slots[slot];
+}
+
+/**
+ * @brief Returns the string identified by a code.
+ * @param pool The pool.
+ * @param code The code of the string.
+ * @return The string, or NULL if the code is not valid.
+ */
+const char* stringPoolGet(PtStringPool pool, int code) {
+    if (pool == NULL || code < 0 || code >= pool->size) return NULL;
+
+    return pool->strings[code];
+}
+
+/**
+ * @brief Returns the number of distinct strings in the pool.
+ * @param pool The pool.
+ * @return Number of strings.
+ */
+int stringPoolSize(PtStringPool pool) {
+    return pool != NULL ? pool->size : 0;
+}
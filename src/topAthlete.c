@@ -10,9 +10,33 @@
  */
 
 #include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 #include "topAthlete.h"
 
+#define INITIAL_GAMES_CAPACITY 4
+
+/**
+ * @brief Initializes an empty top athlete record.
+ * 
+ * @param top Pointer to the TopAthlete structure to initialize.
+ * @param athleteID ID of the athlete.
+ * @param country Country the athlete represented.
+ */
+void initTopAthlete(TopAthlete *top, const char *athleteID, const char *country) {
+    strncpy(top->athlete, athleteID, MAX_ID_LENGTH - 1);
+    top->athlete[MAX_ID_LENGTH - 1] = '\0';
+
+    strncpy(top->country, country, MAX_TOP_COUNTRY_LENGTH - 1);
+    top->country[MAX_TOP_COUNTRY_LENGTH - 1] = '\0';
+
+    top->totalMedals = 0;
+    top->medalsPerGame = NULL;
+    top->medalsPerGameSize = 0;
+    top->medalsPerGameCapacity = 0;
+    top->daysPlayed = 0;
+}
+
 /**
  * @brief Retrieves a pointer to the medals awarded in a specific game for a given athlete.
  * 
@@ -23,7 +47,7 @@
  * @param game String representing the game to search for.
  * @return Pointer to the MedalsPerGame structure if found, NULL otherwise.
  */
-MedalsPerGame* getMedalsPerGame(TopAthlete *top, char *game) {
+MedalsPerGame* getMedalsPerGame(TopAthlete *top, const char *game) {
     for(int i = 0; i < top->medalsPerGameSize; i++) {
         if(strcmp(top->medalsPerGame[i].game, game) == 0)
             return &top->medalsPerGame[i];
@@ -40,8 +64,38 @@ MedalsPerGame* getMedalsPerGame(TopAthlete *top, char *game) {
  * 
  * @param top Pointer to a TopAthlete structure where the medals per game will be added.
  * @param medalsPerGame The MedalsPerGame structure to add to the athlete's record.
+ * @return True if the entry was added, false on memory allocation failure.
  */
-void addMedalsPerGame(TopAthlete *top, MedalsPerGame medalsPerGame) {
-    top->medalsPerGame[top->medalsPerGameSize-1] = medalsPerGame;
-    top->medalsPerGameSize++;
+bool addMedalsPerGame(TopAthlete *top, MedalsPerGame medalsPerGame) {
+    if(top->medalsPerGameSize == top->medalsPerGameCapacity) {
+        int newCapacity = top->medalsPerGameCapacity > 0 ? top->medalsPerGameCapacity * 2 : INITIAL_GAMES_CAPACITY;
+
+        MedalsPerGame *newGames = realloc(top->medalsPerGame, newCapacity * sizeof(MedalsPerGame));
+        if(newGames == NULL) return false;
+
+        top->medalsPerGame = newGames;
+        top->medalsPerGameCapacity = newCapacity;
+    }
+
+    top->medalsPerGame[top->medalsPerGameSize++] = medalsPerGame;
+
+    return true;
+}
+
+/**
+ * @brief Frees a top N result and every athlete record it holds.
+ * 
+ * @param ptResult Address of the pointer to the result, set to NULL afterwards.
+ */
+void destroyTopNResult(TopNResult **ptResult) {
+    if(ptResult == NULL || *ptResult == NULL) return;
+
+    TopNResult *result = *ptResult;
+    for(int i = 0; i < result->count; i++)
+        free(result->athletes[i].medalsPerGame);
+
+    free(result->athletes);
+    free(result);
+
+    *ptResult = NULL;
 }
\ No newline at end of file